@@ -0,0 +1,163 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+# Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+import nogui/async/[core, pool]
+import wip/image/[context, layer, proxy]
+import wip/[image, brush, texture]
+import wip/brush/record
+from std/monotimes import getMonoTime, ticks
+from std/strutils import toHex, toUpperAscii
+from std/os import commandLineParams, `/`
+
+# ------------------------
+# Headless Replay Profiler
+# ------------------------
+
+type
+  NReplayProfile = object
+    brush: NBrushProfile
+    # Accumulated Nanoseconds
+    dispatch, composite, commit: int64
+
+template measure(t: var int64, body: untyped) =
+  let t0 = ticks getMonoTime()
+  body
+  t += ticks(getMonoTime()) - t0
+
+proc report(profile: NReplayProfile, strokes: int) =
+  let
+    p = profile.brush
+    secs = float64(profile.dispatch) * 1e-9
+    rate = if secs > 0.0: float64(p.dabs) / secs else: 0.0
+  echo "strokes:   ", strokes
+  echo "dabs:      ", p.dabs, " (", int(rate), " dabs/sec)"
+  echo "stage0:    ", p.stage0 div 1_000_000, " ms"
+  echo "stage1:    ", p.stage1 div 1_000_000, " ms"
+  echo "stream:    ", p.stream div 1_000_000, " ms"
+  echo "composite: ", profile.composite div 1_000_000, " ms"
+  echo "commit:    ", profile.commit div 1_000_000, " ms"
+
+# -----------------------
+# Headless Replay Canvas
+# -----------------------
+
+proc prepare(image: NImage, brush: var NBrushStroke) =
+  const bpp = cint(sizeof cushort)
+  let
+    ctx = addr image.ctx
+    proxy = addr image.proxy
+    target = addr brush.pipe.canvas
+  proxy[].prepare(image.target)
+  # Prepare Brush Engine Buffers
+  let
+    mapColor = ctx[].mapAux(bpp * 4)
+    mapShape = ctx[].mapAux(bpp * 4)
+  target.w = ctx.w
+  target.h = ctx.h
+  target.stride = proxy.map.stride shr 3
+  target.dst = cast[ptr cshort](proxy.map.buffer)
+  target.buffer0 = cast[ptr cshort](mapColor.buffer)
+  target.buffer1 = cast[ptr cshort](mapShape.buffer)
+  # Prepare Brush Stroke
+  brush.proxy = proxy
+  brush.clear()
+
+proc hash(image: NImage): uint64 =
+  let
+    ctx = addr image.ctx
+    map = ctx[].mapFlat(0)
+    bytes = int(ctx.w) * 4
+  # FNV-1a Hash of Composited Image
+  result = 0xcbf29ce484222325'u64
+  var row = cast[ptr UncheckedArray[uint8]](map.buffer)
+  for y in 0 ..< ctx.h:
+    for x in 0 ..< bytes:
+      result = result xor uint64(row[x])
+      result = result * 0x100000001b3'u64
+    # Next Row
+    row = cast[ptr UncheckedArray[uint8]](addr row[map.stride])
+
+# ------------------------
+# Headless Replay Dispatch
+# ------------------------
+
+proc replay(image: NImage, pool: NThreadPool, records: seq[NStrokeRecord],
+    textures: openArray[ptr NTexture]): NReplayProfile =
+  var brush: NBrushStroke
+  brush.pipe.pool = pool
+  brush.pipe.stamps.configure(32 shl 20)
+  brush.profile = addr result.brush
+  # Replay Each Stroke
+  pool.start()
+  for rec in records:
+    if not rec.apply(brush, textures):
+      continue
+    image.prepare(brush)
+    brush.prepare()
+    for e in rec.events:
+      if e.press == 2.0: brush.skip()
+      else: brush.point(e.x, e.y, e.press, e.angle)
+      # Render Available Lines
+      var takes = 0
+      measure(result.dispatch):
+        while brush.take():
+          brush.dispatch()
+          inc(takes)
+      # Composite Like Canvas
+      if takes > 0:
+        measure(result.composite):
+          image.flatten(pool)
+    # Commit Stroke to Layer
+    measure(result.commit):
+      image.proxy.commit()
+      clearAux(image.ctx)
+  # Composite Final Image
+  for check in mitems(image.status.flat):
+    check = 0
+  image.flatten(pool)
+  pool.stop()
+
+# --------------------
+# Headless Replay Main
+# --------------------
+
+proc main() =
+  let args = commandLineParams()
+  if len(args) < 1:
+    echo "usage: replay <record> [data] [hash]"
+    quit(1)
+  # Load Stroke Records
+  let records = readRecords(args[0])
+  if len(records) == 0:
+    echo "[ERROR] no strokes found: ", args[0]
+    quit(1)
+  let
+    data = if len(args) > 1: args[1] else: "pack"
+    pool = getPool()
+    cache = createTextureCache(pool)
+    textures = [
+      cache.texture(data / "proof/tex0.png"),
+      cache.texture(data / "proof/tex1.png"),
+      cache.texture(data / "proof/tex2.png")]
+  # Decode Textures Before Replay
+  cache.preload()
+  # Create Headless Image
+  let
+    rec0 = records[0]
+    image = createImage(rec0.w, rec0.h)
+    layer = image.createLayer(lkColor16)
+  layer.props.flags.incl(lpVisible)
+  layer.props.opacity = 1.0
+  image.root.attachInside(layer)
+  image.selectLayer(layer)
+  # Replay Strokes and Report
+  let profile = image.replay(pool, records, textures)
+  let h = image.hash()
+  profile.report(len records)
+  echo "hash:      ", toHex(h)
+  # Check Expected Hash
+  if len(args) > 2 and toUpperAscii(args[2]) != toHex(h):
+    echo "[ERROR] replay hash mismatch"
+    quit(1)
+
+when isMainModule:
+  main()
@@ -79,7 +79,9 @@ widget UXPainterDispatch:
     self.tools[stSelect] = uxShape
     self.tools[stBrush] = uxBrush
     self.tools[stEraser] = uxBrush
-    self.tools[stFill] = uxbucketdispatch(state.bucket)
+    let uxBucket = uxbucketdispatch(state.bucket)
+    self.tools[stWand] = uxBucket
+    self.tools[stFill] = uxBucket
     self.tools[stCanvas] = uxcanvasdispatch(state.canvas)
     self.tools[stShapes] = uxShape
     # Initialize State
@@ -49,7 +49,7 @@ controller CXToolDock:
     lo[stMove] = dummy
     lo[stLasso] = self.dockLasso.dock
     lo[stSelect] = self.dockSelect.dock
-    lo[stWand] = dummy
+    lo[stWand] = self.dockBucket.dock
     # Painting Tools
     lo[stBrush] = self.dockBrush.dock
     lo[stEraser] = self.dockBrush.dock
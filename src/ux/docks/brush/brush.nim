@@ -241,6 +241,7 @@ controller CXBrushDock:
     let section =
       form().child:
         field("Stabilizer"): slider(basic.stabilizer)
+        field("Prediction"): slider(basic.prediction)
         separator() # Pressure Curves
         label("Pressure Curves", hoLeft, veMiddle)
         field("Size"): dual0float(basic.sizeAmp, fmtAmplify)
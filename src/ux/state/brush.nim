@@ -23,6 +23,7 @@ type
     opacityAmp*: @ LinearDual
     # Stabilizer Level
     stabilizer*: @ Linear
+    prediction*: @ Linear
   CXBrushCircle = object
     hardness*: @ Linear
     sharpness*: @ Linear
@@ -153,6 +154,7 @@ controller CXBrush:
       liAngle = linear(0, 360)
       duAmp = dual(0.25, 1.0, 4)
       liStabilizer = linear(0, 64)
+      liPrediction = linear(0, 32)
     # Initialize Basics
     basic.size = liSize
     basic.sizeMin = liBasic
@@ -161,6 +163,7 @@ controller CXBrush:
     basic.opacityMin = liBasic
     basic.opacityAmp = duAmp
     basic.stabilizer = liStabilizer
+    basic.prediction = liPrediction
     # Initialize Circle
     circle.hardness = liBasic
     circle.sharpness = liBasic
@@ -232,6 +235,7 @@ proc proof0basic(basic: ptr CXBrushBasic) =
   lerp basic.opacityAmp.peek[], 0.5
   # Default Stabilizer
   lorp basic.stabilizer.peek[], 4
+  lorp basic.prediction.peek[], 0
 
 proc proof0shapes(shape: ptr CXBrushShape) =
   let
@@ -317,6 +321,17 @@ proc brush0coro(coro: Coroutine[BrushTask]) =
       dec(steps)
     # Composite Canvas
     if takes > 0 and data.composite == 0:
+      var check = false
+      coro.lock():
+        check = brush[].predicted()
+      # Render Predicted Dabs
+      if check: brush[].speculate()
+      data.canvas.composite()
+      data.composite = high(uint64)
+      coro.send(data.cbStream)
+    # Discard Predicted Dabs Without New Input
+    elif takes == 0 and data.composite == 0 and brush[].expired():
+      brush[].rollback()
       data.canvas.composite()
       data.composite = high(uint64)
       coro.send(data.cbStream)
@@ -341,12 +356,14 @@ widget UXBrushTask:
     # Current Canvas Instance
     proxy: ptr NImageProxy
     stabilizer: NBrushStabilizer
+    predictor: NBrushPredictor
 
   proc prepare(proxy: ptr NImageProxy) =
     let brush = addr self.engine.brush
     # Prepare Brush Proxy
     self.proxy = proxy
     brush.proxy = proxy
+    self.engine.recordStart0proof()
     brush[].prepare()
     # Forward Widget Grab
     self.send(wsForward)
@@ -390,6 +407,7 @@ widget UXBrushTask:
     let
       engine {.cursor.} = self.engine
       stable = addr self.stabilizer
+      ahead = addr self.predictor
       brush = addr engine.brush
       affine = engine.canvas.affine
       # Transfrom Point to Canvas Coordinates
@@ -401,17 +419,29 @@ widget UXBrushTask:
     coro.lock():
       if state.kind == evCursorClick:
         reset(self.stabilizer, self.stabilizer.capacity)
+        reset(self.predictor, self.predictor.lead)
       if self.test(wGrab):
         if capacity > 0:
           let ps = stable[].smooth(p.x, p.y, press, 0.0)
           brush[].point(ps.x, ps.y, ps.press, 0.0)
-        else: brush[].point(p.x, p.y, press, 0.0)
+          engine.record.point(ps.x, ps.y, ps.press, 0.0)
+          ahead[].track(ps.x, ps.y, ps.press)
+        else:
+          brush[].point(p.x, p.y, press, 0.0)
+          engine.record.point(p.x, p.y, press, 0.0)
+          ahead[].track(p.x, p.y, press)
+        # Predict Next Point
+        var pp: NBrushStable
+        if ahead[].predict(pp):
+          brush[].predict(pp.x, pp.y, pp.press)
       # Terminate Brush Stroke
       elif state.kind == evCursorRelease:
         for _ in 0 ..< capacity:
           let ps = stable[].smooth(p.x, p.y, press, 0.0)
           brush[].point(ps.x, ps.y, ps.press, 0.0)
+          engine.record.point(ps.x, ps.y, ps.press, 0.0)
         brush[].skip()
+        engine.record.skip()
 
   method handle(reason: GUIHandle) =
     let engine {.cursor.} = self.engine
@@ -422,7 +452,10 @@ widget UXBrushTask:
       coro.spawn()
     of outHold:
       coro.wait()
+      # Discard Predicted Dabs
+      engine.brush.rollback()
       engine.commit0proof()
+      engine.recordFinish0proof()
     else: discard
 
 # ---------------------
@@ -460,6 +493,7 @@ widget UXBrushDispatch:
     b1.amp_alpha = toFloat b0.opacityAmp.peek[]
     # Configure Stabilizer, TODO: move to engine side
     reset(self.task.stabilizer, toInt b0.stabilizer.peek[])
+    reset(self.task.predictor, cfloat b0.prediction.peek[].toFloat)
 
   proc prepareColor() =
     let
@@ -476,6 +510,7 @@ widget UXBrushDispatch:
     var glass = c.eraser.peek[]
     glass = glass or brush0.engine.tool == stEraser
     brush[].color(r, g, b, glass)
+    brush0.engine.record.color(r, g, b, glass)
 
   # -- Shape State -> Engine --
   proc prepareCircle() =
@@ -506,7 +541,7 @@ widget UXBrushDispatch:
     blot1.invert = blot0.invert.peek[]
     # Configure Shape Mode
     brush.shape = bsBlotmap
-    blot1.texture = addr brush0.engine.tex0
+    blot1.texture = brush0.engine.tex0
 
   proc prepareBitmap() =
     let
@@ -530,7 +565,7 @@ widget UXBrushDispatch:
     bm1.auto_angle = if bm0.angleAuto.peek[]: 255 else: 0
     # Configure Bitmap Mode
     brush.shape = bsBitmap
-    bm1.texture = addr brush0.engine.tex1
+    bm1.texture = brush0.engine.tex1
 
   # -- Texture State -> Engine --
   proc prepareTexture() =
@@ -547,7 +582,7 @@ widget UXBrushDispatch:
     # Configure Texture Scratch
     tex1.scratch = toRaw tex0.scratch.peek[]
     tex1.p_scratch = toRaw tex0.minScratch.peek[]
-    tex1.texture = addr brush0.engine.tex2
+    tex1.texture = brush0.engine.tex2
 
   # -- Blending State -> Engine --
   proc prepareWater(mode: NBrushBlend) =
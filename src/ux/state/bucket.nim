@@ -5,6 +5,7 @@ import nogui/ux/prelude
 import nogui/builder
 # Import Engine State
 import ../../wip/canvas/matrix
+import ../../wip/undo
 import engine, color
 
 # -----------------------
@@ -79,17 +80,38 @@ widget UXBucketDispatch:
       x = int32 p.x
       y = int32 p.y
     # Configure Bucket - proof of concept
-    discard engine.proxyBucket0proof()
+    let merged = bucket.target.peek[] == ord bctCanvas
+    discard engine.proxyBucket0proof(merged)
     fill.tolerance = cint(bucket.threshold.peek[].toRaw * 255)
     fill.gap = cint(bucket.gap.peek[].toRaw * 255)
     fill.check = bucket.modecheck
     fill.antialiasing = bucket.antialiasing.peek[]
     fill.rgba = bucket.color.color32()
+    # Dispatch Wand Selection
+    if engine.tool == stWand:
+      let
+        undo = canvas[].undo
+        mask = canvas[].image.mask
+        step = undo.push(ucLayerMark)
+      # Replace Selection with Undo
+      step.capture(mask)
+      engine.secure.startPool()
+      fill[].wand(mask.tiles, x, y)
+      engine.secure.stopPool()
+      engine.release0proof()
+      step.capture(mask)
+      undo.flush()
+      # Update Selection Render
+      canvas[].update()
+      getWindow().fuse()
+      return
     # Dispatch Position
+    engine.secure.startPool()
     if fill.check != bkSimilar:
       fill[].flood(x, y)
     else: fill[].similar(x, y)
     fill[].blend()
+    engine.secure.stopPool()
     # Update Render Region
     engine.commit0proof()
 
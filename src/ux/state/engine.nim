@@ -6,11 +6,13 @@ import nogui/data {.all.}
 # Import NPainter Engine
 import ../../wip/image/[context, proxy]
 import ../../wip/[undo, brush, texture, binary, canvas]
+import ../../wip/brush/record
 from ../../wip/image import createLayer, selectLayer
 # TODO: move to engine side
 import nogui/async/core as async
 import nogui/libs/gl
 import locks
+from os import getEnv
 
 type
   CKPainterTool* {.size: sizeof(int32).} = enum
@@ -92,7 +94,11 @@ controller NPainterEngine:
     man: NCanvasManager
     canvas: NCanvasImage
     # XXX: Proof Textures
-    [tex0, tex1, tex2]: NTexture
+    textures: NTextureCache
+    [tex0, tex1, tex2]: ptr NTexture
+    # XXX: Proof Stroke Recording
+    record: NStrokeRecord
+    recordFile: string
 
   # TODO: prepare proxy at dispatch side
   proc proxyBrush0proof*: ptr NImageProxy =
@@ -121,10 +127,13 @@ controller NPainterEngine:
     self.brush.clear()
 
   # TODO: prepare proxy at dispatch side
-  proc proxyBucket0proof*: ptr NImageProxy =
+  proc proxyBucket0proof*(merged: bool): ptr NImageProxy =
     const bpp = cint(sizeof cushort)
-    # Prepare Proxy
+    # Refresh Dirty Composite
     let image = self.canvas.image
+    if merged:
+      self.canvas.flatten()
+    # Prepare Proxy
     result = addr image.proxy
     result[].prepare(image.target)
     # Prepare Bucket Tool
@@ -133,16 +142,15 @@ controller NPainterEngine:
       mapColor = ctx[].mapAux(bpp * 4)
       mapShape = ctx[].mapAux(bpp * 4)
     # Configure Bucket Tool
-    self.bucket = configure(
-      result.map.buffer,
+    self.bucket = configure(result,
       # Auxiliar Buffers
       mapColor.buffer,
       mapShape.buffer,
-      ctx.w, ctx.h
-    )
-    # We need mark all buffer
-    result[].mark(0, 0, ctx.w, ctx.h)
-    result[].stream()
+      self.secure.pool)
+    # Sample From Composite
+    if merged:
+      let mapSample = ctx[].mapAux(bpp * 4)
+      self.bucket.sampling(ctx[].mapFlat(0), mapSample)
 
   # TODO: commit proxy at dispatch side
   proc commit0proof*() =
@@ -161,6 +169,25 @@ controller NPainterEngine:
     step.capture(layer)
     undo.flush()
 
+  # TODO: commit proxy at dispatch side
+  proc release0proof*() =
+    let image = self.canvas.image
+    # Release Proxy Without Changes
+    commit(image.proxy)
+    clearAux(image.ctx)
+
+  # XXX: stroke recording for headless replay
+  proc recordStart0proof*() =
+    if len(self.recordFile) == 0:
+      return
+    let ctx = addr self.canvas.image.ctx
+    self.record.start(self.brush, ctx.w, ctx.h,
+      [self.tex0, self.tex1, self.tex2])
+
+  proc recordFinish0proof*() =
+    if len(self.recordFile) > 0:
+      self.record.finish(self.recordFile)
+
   proc bindBackground0proof(checker: cint) =
     let info = addr self.canvas.image.info
     # Primary Color
@@ -204,10 +231,17 @@ controller NPainterEngine:
     result.bindAffine0proof()
     # Initialize Multi-Threading
     result.brush.pipe.pool = pool
+    result.brush.pipe.stamps.configure(32 shl 20)
     # XXX: demo textures meanwhile a picker is done
-    result.tex0 = newPNGTexture(toDataPath "proof/tex0.png")
-    result.tex1 = newPNGTexture(toDataPath "proof/tex1.png")
-    result.tex2 = newPNGTexture(toDataPath "proof/tex2.png")
+    let textures = createTextureCache(pool)
+    result.textures = textures
+    result.tex0 = textures.texture(toDataPath "proof/tex0.png")
+    result.tex1 = textures.texture(toDataPath "proof/tex1.png")
+    result.tex2 = textures.texture(toDataPath "proof/tex2.png")
+    # Decode Textures on Thread Pool
+    textures.preload()
+    # XXX: append strokes to a file for headless replay
+    result.recordFile = getEnv("NPAINTER_RECORD")
 
   # -- Foreign Renderer --
   proc renderGL*() =
@@ -224,6 +258,7 @@ controller NPainterEngine:
 
 export
   brush,
+  record,
   texture,
   binary,
   canvas,
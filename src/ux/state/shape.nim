@@ -7,7 +7,7 @@ import nogui/builder
 # Import Engine State
 import ../../wip/canvas/matrix
 import ../../wip/mask/proxy
-import ../../wip/shape
+import ../../wip/[shape, undo]
 import engine, color
 
 # ----------------------
@@ -172,7 +172,15 @@ widget UXShapeDispatch:
       self.stage = stagePivot
       proxy[].lod = 0
       proxy[].rasterize()
+      # Commit Polygon with Undo
+      let
+        undo = canvas.undo
+        layer = canvas.image.target
+        step = undo.push(ucLayerMark)
+      step.capture(layer)
       proxy[].commit()
+      step.capture(layer)
+      undo.flush()
     else: proxy[].rasterize()
     canvas.update()
 
@@ -114,22 +114,56 @@ let dummy {.nodecl.} = 0
 # This is for proof of concept until NCanvas/NLayer is done
 # ---------------------------------------------------------
 import binary/ffi
+import image/[context, proxy]
+import nogui/async/pool
+from std/bitops import
+  countTrailingZeroBits, countLeadingZeroBits
+from image/tiles import NTileStatus, NTileImage,
+  find, ensure, shrink, clear, toColor, toBuffer
+from image/chunk import mipmaps, combine, clip32
+from image/ffi import NImageBuffer, proxy_stream8
 
 type
   NBucketCheck* = enum
     bkColor, bkAlpha
     bkMinimun, bkSimilar
+  NBucketSeed = object
+    x, y: cint
+  NBucketBand = object
+    chamfer: NDistance
+    smooth: NBinarySmooth
+    aux: pointer
   NBucketProof* = object
     bin: NBinary
     smooth: NBinarySmooth
     clear: NBinaryClear
     flood: NFloodFill
     chamfer: NDistance
+    mix: NBinaryBlend
+    bits: NBinaryBits
     # Stride, Rows
     stride, rows: cint
+    words: cint
     # Buffer Pointers
     s0, s1, s2: pointer
     a0, b0, b1, b2: pointer
+    m0, m1: pointer
+    # Bucket Distance Bands
+    pool: NThreadPool
+    bands: seq[NBucketBand]
+    scratch: seq[byte]
+    # Bucket Sampling
+    src: pointer
+    flat, sample: NImageBuffer
+    merged: bool
+    # Bucket Tiles
+    proxy: ptr NImageProxy
+    ready: seq[bool]
+    stack: seq[NBucketSeed]
+    w32, h32: cint
+    # Bucket Regions
+    aabb, area: NImageMark
+    pix: cuint
     # Bucket Parameters
     tolerance*, gap*: cint
     check*: NBucketCheck
@@ -144,7 +178,7 @@ func index(buffer: pointer; w, h, idx: cint): pointer =
 func pixel(bucket: NBucketProof; x, y: cint): cuint =
   let 
     i = (bucket.stride * y + x) shl 2
-    p = cast[ptr UncheckedArray[cushort]](bucket.s0)
+    p = cast[ptr UncheckedArray[cushort]](bucket.src)
     # Get Colors
     r = cast[cuint](p[i + 0] shr 8)
     g = cast[cuint](p[i + 1] shr 8)
@@ -153,122 +187,545 @@ func pixel(bucket: NBucketProof; x, y: cint): cuint =
   # Merge To 32 Bits
   result = r or (g shl 8) or (b shl 16) or (a shl 24)
 
-proc configure*(buffer0, buffer1, buffer2: pointer; w, h: cint): NBucketProof =
+proc configure*(proxy: ptr NImageProxy; buffer1, buffer2: pointer;
+    pool: NThreadPool): NBucketProof =
   let
+    ctx = proxy.ctx
+    w = ctx.w
+    h = ctx.h
+    # Binary Buffers
+    m0 = index(buffer1, w, h, 0)
+    m1 = index(buffer1, w, h, 1)
     b0 = index(buffer1, w, h, 2)
     b1 = index(buffer1, w, h, 3)
     b2 = index(buffer1, w, h, 4)
     # Auxiliar Buffers
     a0 = index(buffer2, w, h, 4)
-  result.s0 = buffer0
+  result.s0 = proxy.map.buffer
+  result.src = result.s0
   result.s1 = buffer1
   result.s2 = buffer2
   # Configure Pointers
   result.b0 = b0
   result.b1 = b1
   result.b2 = b2
+  # Configure Bit Masks
+  result.m0 = m0
+  result.m1 = m1
   # Configure Auxiliar
   result.a0 = a0
   # Create Auxiliar Buffer
   result.stride = w
   result.rows = h
+  result.words = (w + 63) shr 6
+  # Configure Tiles
+  result.pool = pool
+  result.proxy = proxy
+  result.w32 = ctx.w32 shr 5
+  result.h32 = ctx.h32 shr 5
+  setLen(result.ready, result.w32 * result.h32)
   # Configure Bounds
   result.bin.bounds(w, h)
   result.flood.bounds(w, h)
   result.chamfer.bounds(w, h)
+  result.mix.bounds(w, h)
+  result.bits.bounds(w, result.words)
   # Configure Regions
   result.bin.region(0, 0, w, h)
   result.clear.region(0, 0, w, h)
   result.chamfer.region(0, 0, w, h)
 
-proc flood*(bucket: var NBucketProof, x, y: cint) =
-  let 
-    pix = pixel(bucket, x, y)
-    bytes = bucket.stride * bucket.rows
-    chunk = bytes shl 3
-  var test: cuint = 0xFF
-  # Clear All Buffers
-  zeroMem(bucket.s2, chunk)
-  zeroMem(bucket.s1, chunk)
-  # Convert to Binary
-  bucket.bin.target(bucket.s0, bucket.b0)
+proc sampling*(bucket: var NBucketProof; flat, sample: NImageBuffer) =
+  bucket.flat = flat
+  bucket.sample = sample
+  # Threshold Merged Samples
+  bucket.src = sample.buffer
+  bucket.merged = true
+
+# -------------------------
+# Bucket Tiles: Preparation
+# -------------------------
+
+template mask(buffer: pointer): ptr UncheckedArray[uint8] =
+  cast[ptr UncheckedArray[uint8]](buffer)
+
+proc fill(buffer: pointer; stride, bpp: cint; m: NImageMark, value: uint8) =
+  let
+    bytes = (m.x1 - m.x0) * bpp
+    step = stride * bpp
+  if bytes <= 0: return
+  # Fill Each Region Row
+  var row = (m.y0 * stride + m.x0) * bpp
+  for _ in m.y0 ..< m.y1:
+    setMem(addr mask(buffer)[row], value, bytes)
+    row += step
+
+proc region32(bucket: NBucketProof; tx, ty: cint): NImageMark =
+  let
+    x = tx shl 5
+    y = ty shl 5
+  # Clip Tile to Canvas
+  result = mark(x, y,
+    min(bucket.stride - x, 32),
+    min(bucket.rows - y, 32))
+
+proc threshold(bucket: var NBucketProof, m: NImageMark) =
+  let pix = bucket.pix
+  # Convert Region to Binary
+  bucket.bin.target(bucket.src, bucket.b0)
+  bucket.bin.region(m.x0, m.y0, m.x1 - m.x0, m.y1 - m.y0)
   case bucket.check
   of bkColor, bkSimilar: bucket.bin.toBinary(pix, cuint bucket.tolerance, true)
   of bkAlpha: bucket.bin.toBinary(pix, cuint bucket.tolerance, false)
   of bkMinimun: bucket.bin.toBinary(cuint bucket.tolerance)
-  # First Flood Fill
-  bucket.flood.target(bucket.b0, bucket.b1)
+
+proc pull(bucket: var NBucketProof; tx, ty: cint) =
+  var co = combine(bucket.flat, bucket.sample).clip32(tx, ty)
+  # Stream Composited Tile to Samples
+  proxy_stream8(addr co)
+
+proc load(bucket: var NBucketProof; tx, ty: cint): NTileStatus =
+  let
+    m = bucket.region32(tx, ty)
+    lanes = cast[ptr UncheckedArray[uint32]](bucket.m1)
+    step = bucket.words shl 1
+  bucket.ready[ty * bucket.w32 + tx] = true
+  # Stream Tile and Clear Fill Bits
+  result = bucket.proxy[].stream(tx, ty)
+  if bucket.merged:
+    bucket.pull(tx, ty)
+    result = tsBuffer
+  var idx = m.y0 * step + tx
+  for _ in m.y0 ..< m.y1:
+    lanes[idx] = 0
+    idx += step
+
+proc convert(bucket: var NBucketProof; tx, ty: cint, status: NTileStatus) =
+  let m = bucket.region32(tx, ty)
+  if status == tsBuffer:
+    bucket.threshold(m)
+  else: # Uniform Tile Fast Path
+    let stride = bucket.stride
+    bucket.threshold mark(m.x0, m.y0, 1, 1)
+    let value = mask(bucket.b0)[m.y0 * stride + m.x0]
+    fill(bucket.b0, stride, 1, m, value)
+  # Pack Binary Tile to Bits
+  bucket.bits.target(bucket.b0, bucket.m0)
+  bucket.bits.region(m.x0, m.y0, m.x1 - m.x0, m.y1 - m.y0)
+  bucket.bits.pack()
+
+proc prepare(bucket: var NBucketProof; tx, ty: cint) =
+  let idx = ty * bucket.w32 + tx
+  if bucket.ready[idx]:
+    return
+  # Stream and Convert Tile
+  let status = bucket.load(tx, ty)
+  bucket.convert(tx, ty, status)
+  # Complete 64 Pixels Word
+  let buddy = tx xor 1
+  if buddy < bucket.w32:
+    bucket.prepare(buddy, ty)
+
+proc prepare(bucket: var NBucketProof; m: NImageMark) =
+  let
+    tx0 = max(m.x0 - 1, 0) shr 5
+    ty0 = max(m.y0 - 1, 0) shr 5
+    tx1 = min(m.x1 shr 5, bucket.w32 - 1)
+    ty1 = min(m.y1 shr 5, bucket.h32 - 1)
+  # Prepare Region Tiles and Surrounding
+  for ty in ty0 .. ty1:
+    for tx in tx0 .. tx1:
+      bucket.prepare(tx, ty)
+
+proc walls(bucket: var NBucketProof; buffer: pointer; bpp: cint) =
+  let
+    m = bucket.area
+    stride = bucket.stride
+    # Surrounding Region Clipped
+    x0 = max(m.x0 - 1, 0)
+    y0 = max(m.y0 - 1, 0)
+    x1 = min(m.x1 + 1, stride)
+    y1 = min(m.y1 + 1, bucket.rows)
+  # Clear Surrounding Rows
+  if y0 < m.y0: fill(buffer, stride, bpp, mark(x0, y0, x1 - x0, 1), 0)
+  if y1 > m.y1: fill(buffer, stride, bpp, mark(x0, m.y1, x1 - x0, 1), 0)
+  # Clear Surrounding Columns
+  let h = m.y1 - m.y0
+  if x0 < m.x0: fill(buffer, stride, bpp, mark(x0, m.y0, 1, h), 0)
+  if x1 > m.x1: fill(buffer, stride, bpp, mark(m.x1, m.y0, 1, h), 0)
+
+proc finish(bucket: var NBucketProof) =
+  let
+    m = bucket.area
+    status = bucket.proxy.status
+    # Area Tile Region
+    tx0 = m.x0 shr 5
+    ty0 = m.y0 shr 5
+    tx1 = (m.x1 + 0x1F) shr 5
+    ty1 = (m.y1 + 0x1F) shr 5
+  # Unmark Tiles Outside Area
+  var idx: cint
+  for ty in 0 ..< bucket.h32:
+    for tx in 0 ..< bucket.w32:
+      let inside = tx >= tx0 and tx < tx1 and ty >= ty0 and ty < ty1
+      if bucket.ready[idx] and not inside:
+        status.aux[idx] = 0
+      inc(idx)
+  # Clip Status to Area
+  status.clip = m
+
+# ------------------------
+# Bucket Tiles: Flood Fill
+# ------------------------
+
+template bits64(buffer: pointer): ptr UncheckedArray[uint64] =
+  cast[ptr UncheckedArray[uint64]](buffer)
+
+proc occupied(bucket: NBucketProof; x, y: cint): uint64 {.inline.} =
+  let idx = y * bucket.words + x shr 6
+  bits64(bucket.m0)[idx] or bits64(bucket.m1)[idx]
+
+proc left(bucket: var NBucketProof; x, y: cint): cint =
+  var x = x
+  while x >= 0:
+    bucket.prepare(x shr 5, y shr 5)
+    # Find Nearest Boundary Bit at Left
+    let check = bucket.occupied(x, y) shl (63 - (x and 63))
+    if check != 0:
+      return x - cint(countLeadingZeroBits check) + 1
+    # Previous Word
+    x = (x and not 63) - 1
+
+proc right(bucket: var NBucketProof; x, y: cint): cint =
+  let w = bucket.stride
+  var x = x
+  while x < w:
+    bucket.prepare(x shr 5, y shr 5)
+    # Find Nearest Boundary Bit at Right
+    let check = bucket.occupied(x, y) shr (x and 63)
+    if check != 0:
+      return min(x + cint(countTrailingZeroBits check), w)
+    # Next Word
+    x = (x or 63) + 1
+  # Reached Canvas Boundary
+  result = w
+
+proc span(bucket: var NBucketProof; x0, x1, y: cint) =
+  let
+    row = y * bucket.words
+    m1 = bits64(bucket.m1)
+  var x = x0
+  # Fill Span Words
+  while x < x1:
+    let
+      s = x and 63
+      l = min(x1 - x, 64 - s)
+      bits = (not 0'u64 shr (64 - l)) shl s
+      idx = row + x shr 6
+    m1[idx] = m1[idx] or bits
+    x += l
+
+proc seeds(bucket: var NBucketProof; x0, x1, y: cint) =
+  var
+    x = x0
+    prev: uint64
+  while x < x1:
+    bucket.prepare(x shr 5, y shr 5)
+    let
+      s = x and 63
+      l = min(x1 - x, 64 - s)
+      blank = (not bucket.occupied(x, y) shr s) and (not 0'u64 shr (64 - l))
+    # Push Seed at Each Blank Run Start
+    var starts = blank and not (blank shl 1 or prev)
+    while starts != 0:
+      let i = cint countTrailingZeroBits(starts)
+      bucket.stack.add NBucketSeed(x: x + i, y: y)
+      starts = starts and (starts - 1)
+    # Carry Last Blank Bit
+    prev = (blank shr (l - 1)) and 1
+    x += l
+
+proc scanline(bucket: var NBucketProof; x, y: cint) =
+  let h = bucket.rows
+  setLen(bucket.stack, 0)
+  bucket.stack.add NBucketSeed(x: x, y: y)
+  # Fill Spans Pulling Tiles on Demand
+  while len(bucket.stack) > 0:
+    let s = bucket.stack.pop()
+    bucket.prepare(s.x shr 5, s.y shr 5)
+    if ((bucket.occupied(s.x, s.y) shr (s.x and 63)) and 1) != 0:
+      continue
+    # Expand Span Using Words
+    let
+      x0 = bucket.left(s.x, s.y)
+      x1 = bucket.right(s.x, s.y)
+    bucket.span(x0, x1, s.y)
+    bucket.aabb.expand(x0, s.y, x1 - x0, 1)
+    # Seed Neighbour Spans
+    if s.y > 0: bucket.seeds(x0, x1, s.y - 1)
+    if s.y + 1 < h: bucket.seeds(x0, x1, s.y + 1)
+
+proc unpack(bucket: var NBucketProof; m: NImageMark) =
+  bucket.bits.target(bucket.b1, bucket.m1)
+  bucket.bits.region(m.x0, m.y0, m.x1 - m.x0, m.y1 - m.y0)
+  bucket.bits.unpack()
+
+# ----------------------
+# Bucket Tool Dispatches
+# ----------------------
+
+proc pad(bucket: NBucketProof; m: NImageMark, r: cint): NImageMark =
+  result = mark(m.x0 - r, m.y0 - r,
+    m.x1 - m.x0 + r * 2, m.y1 - m.y0 + r * 2)
+  result.intersect(0, 0, bucket.stride, bucket.rows)
+
+proc mt_cols(band: ptr NBucketBand) =
+  band.chamfer.dispatch_cols(band.aux)
+
+proc mt_rows(band: ptr NBucketBand) =
+  band.chamfer.dispatch_rows(band.aux)
+
+proc exact(bucket: var NBucketProof) =
+  let
+    m = bucket.area
+    w = m.x1 - m.x0
+    h = m.y1 - m.y0
+    pool = bucket.pool
+    # Distance Bands of 64 Lines
+    cols = (w + 63) shr 6
+    rows = (h + 63) shr 6
+    bytes = max(w, h) * 16
+  # Prepare Distance Bands
+  setLen(bucket.bands, max(cols, rows))
+  setLen(bucket.scratch, len(bucket.bands) * bytes)
+  for i, band in mpairs(bucket.bands):
+    band.chamfer = bucket.chamfer
+    band.aux = addr bucket.scratch[i * bytes]
+  # Dispatch Column Bands
+  for i in 0 ..< cols:
+    let
+      band = addr bucket.bands[i]
+      x = cint(i) shl 6
+    band.chamfer.region(m.x0 + x, m.y0, min(w - x, 64), h)
+    pool.spawn(mt_cols, band)
+  pool.sync()
+  # Dispatch Row Bands
+  for i in 0 ..< rows:
+    let
+      band = addr bucket.bands[i]
+      y = cint(i) shl 6
+    band.chamfer.region(m.x0, m.y0 + y, w, min(h - y, 64))
+    pool.spawn(mt_rows, band)
+  pool.sync()
+
+proc mt_dilate(band: ptr NBucketBand) =
+  band.smooth.dilate()
+
+proc mt_magic(band: ptr NBucketBand) =
+  band.smooth.magic()
+
+proc mt_apply(band: ptr NBucketBand) =
+  band.smooth.apply()
+
+proc mt_convert(band: ptr NBucketBand) =
+  band.smooth.convert()
+
+proc antialias(bucket: var NBucketProof; test: cuint) =
+  let
+    m = bucket.area
+    w = m.x1 - m.x0
+    h = m.y1 - m.y0
+    pool = bucket.pool
+    # Smooth Bands of 64 Rows
+    rows = (h + 63) shr 6
+  bucket.smooth.toSmooth(bucket.bin, bucket.rgba, test)
+  bucket.smooth.auxiliar(cast[ptr cushort](bucket.b2))
+  # Prepare Smooth Bands
+  if len(bucket.bands) < rows:
+    setLen(bucket.bands, rows)
+  for i in 0 ..< rows:
+    let
+      band = addr bucket.bands[i]
+      y = cint(i) shl 6
+    band.smooth = bucket.smooth
+    band.smooth.region(m.x0, m.y0 + y, w, min(h - y, 64))
+  # Dispatch Each Smooth Pass
+  template stage(fn: untyped) =
+    for i in 0 ..< rows:
+      pool.spawn(fn, addr bucket.bands[i])
+    pool.sync()
+  stage(mt_dilate)
+  stage(mt_magic)
+  stage(mt_apply)
+  stage(mt_convert)
+
+proc gaps(bucket: var NBucketProof; x, y: cint) =
+  let
+    m = bucket.area
+    w = m.x1 - m.x0
+    h = m.y1 - m.y0
+    positions = cast[ptr cuint](bucket.s2)
+    distances = cast[ptr cuint](bucket.a0)
+  bucket.chamfer.region(m.x0, m.y0, w, h)
+  bucket.chamfer.auxiliars(positions, distances)
+  bucket.chamfer.checks(255, bucket.gap)
+  # Erode Dilate Using Exact Distances
+  bucket.chamfer.buffers(bucket.b1, bucket.b0)
+  bucket.exact()
+  bucket.chamfer.buffers(bucket.b0, bucket.b0)
+  bucket.exact()
+  # Invert Area and Wall Surrounding
+  let d = mask(bucket.b0)
+  var row = m.y0 * bucket.stride + m.x0
+  for _ in 0 ..< h:
+    for i in row ..< row + w: d[i] = not d[i]
+    row += bucket.stride
+  bucket.walls(bucket.b0, 1)
+  # Perform Gap Closing
+  bucket.flood.target(bucket.b1, bucket.b0)
   bucket.flood.stack cast[ptr cshort](bucket.b2)
-  bucket.flood.dispatch(x, y, false)
-  # Close Gaps
+  bucket.flood.dispatch(x, y, true)
+  # Shrink Area to Gap Closing AABB
+  let r = bucket.flood.aabb()
+  bucket.aabb = mark(r.x1, r.y1, r.x2 - r.x1, r.y2 - r.y1)
+
+proc seed(bucket: var NBucketProof, x, y: cint): bool =
+  if x < 0 or y < 0 or x >= bucket.stride or y >= bucket.rows:
+    return false
+  # Stream Seed Tile
+  let
+    tx = x shr 5
+    ty = y shr 5
+    status = bucket.load(tx, ty)
+  bucket.pix = pixel(bucket, x, y)
+  bucket.convert(tx, ty, status)
+  # First Flood Fill
+  bucket.scanline(x, y)
+  let m0 = bucket.aabb
+  result = m0.x0 < m0.x1 and m0.y0 < m0.y1
+  if not result:
+    bucket.area = mark(0, 0, 0, 0)
+
+proc flood*(bucket: var NBucketProof, x, y: cint) =
+  if not bucket.seed(x, y):
+    return
+  let m0 = bucket.aabb
+  # Close Gaps Around Fill AABB
+  var test: cuint = 0xFF
   if bucket.gap > 0:
-    let 
-      positions = cast[ptr cuint](bucket.s2)
-      distances = cast[ptr cuint](bucket.a0)
-    bucket.chamfer.auxiliars(positions, distances)
-    bucket.chamfer.checks(255, bucket.gap)
-    # Fast Erode Dilate Using Chamfer
-    bucket.chamfer.buffers(bucket.b1, bucket.b0)
-    bucket.chamfer.dispatch_almost()
-    bucket.chamfer.buffers(bucket.b0, bucket.b0)
-    bucket.chamfer.dispatch_almost()
-    # TODO: after NCanvas/NLayer and some gui i will refactor
-    let d = cast[ptr UncheckedArray[uint8]](bucket.b0)
-    for i in 0 ..< bytes: d[i] = not d[i]
-    # Perform Gap Closing
-    bucket.flood.target(bucket.b1, bucket.b0)
-    bucket.flood.dispatch(x, y, true)
+    bucket.area = bucket.pad(m0, bucket.gap)
+    bucket.prepare(bucket.area)
+    bucket.unpack bucket.pad(bucket.area, 1)
+    bucket.gaps(x, y)
     # Convert Gaps
     test = 0x7F
+  # Antialiasing Area Around Fill AABB
+  let m = bucket.pad(bucket.aabb, cint bucket.antialiasing)
+  bucket.area = m
+  bucket.prepare(m)
+  if bucket.gap == 0:
+    bucket.unpack bucket.pad(m, 1)
+  bucket.walls(bucket.b2, 2)
   # Convert and Apply Color
   bucket.bin.target(bucket.s2, bucket.b1)
+  bucket.bin.region(m.x0, m.y0, m.x1 - m.x0, m.y1 - m.y0)
   if bucket.antialiasing:
-    bucket.smooth.toSmooth(bucket.bin, bucket.rgba, test)
-    bucket.smooth.auxiliar(cast[ptr cushort](bucket.b2))
-    bucket.smooth.dispatch()
+    bucket.antialias(test)
   else: bucket.bin.toColor(bucket.rgba, test)
 
 proc similar*(bucket: var NBucketProof, x, y: cint) =
-  let 
-    pix = pixel(bucket, x, y)
-    bytes = (bucket.stride * bucket.rows) shl 3
+  let
+    w = bucket.stride
+    h = bucket.rows
+    bytes = (w * h) shl 3
+  if x < 0 or y < 0 or x >= w or y >= h:
+    return
+  # Stream Whole Layer
+  bucket.proxy[].mark(0, 0, w, h)
+  bucket.proxy[].stream()
+  bucket.area = mark(0, 0, w, h)
+  if bucket.merged:
+    for ty in 0 ..< bucket.h32:
+      for tx in 0 ..< bucket.w32:
+        bucket.pull(tx, ty)
+  bucket.pix = pixel(bucket, x, y)
   # Clear All Buffers
   zeroMem(bucket.s2, bytes)
   zeroMem(bucket.s1, bytes)
   # Convert to Binary
-  bucket.bin.target(bucket.s0, bucket.b0)
-  bucket.bin.toBinary(pix, cuint bucket.tolerance, true)
+  bucket.threshold(bucket.area)
   # Apply Color
   bucket.bin.target(bucket.s2, bucket.b0)
   if bucket.antialiasing:
-    bucket.smooth.toSmooth(bucket.bin, bucket.rgba, 0)
-    bucket.smooth.auxiliar(cast[ptr cushort](bucket.b2))
-    bucket.smooth.dispatch()
+    bucket.antialias(0)
   else: bucket.bin.toColor(bucket.rgba, 0)
 
 proc blend*(bucket: var NBucketProof) =
-  let # TODO: change when NLayer is done
-    src = cast[ptr UncheckedArray[cushort]](bucket.s2)
-    dst = cast[ptr UncheckedArray[cushort]](bucket.s0)
-    l = cint(bucket.stride * bucket.rows * 4)
-  var cursor: cint; while cursor < l:
-    let
-      # Source Colors
-      rsrc: cuint = src[cursor + 0]
-      gsrc: cuint = src[cursor + 1]
-      bsrc: cuint = src[cursor + 2]
-      asrc: cuint = src[cursor + 3]
-      # Destination Colors
-      rdst: cuint = dst[cursor + 0]
-      gdst: cuint = dst[cursor + 1]
-      bdst: cuint = dst[cursor + 2]
-      adst: cuint = dst[cursor + 3]
-      # Interpolator
-      a: cuint = 65535 - asrc
-    # Blend Two Colors
-    dst[cursor + 0] = cast[cushort](rsrc + ((rdst * a + a) shr 16))
-    dst[cursor + 1] = cast[cushort](gsrc + ((gdst * a + a) shr 16))
-    dst[cursor + 2] = cast[cushort](bsrc + ((bdst * a + a) shr 16))
-    dst[cursor + 3] = cast[cushort](asrc + ((adst * a + a) shr 16))
-    # Next Pixel
-    cursor += 4
+  let m = bucket.area
+  # Blend Color to Area
+  bucket.mix.target(bucket.s2, bucket.s0)
+  bucket.mix.region(m.x0, m.y0, m.x1 - m.x0, m.y1 - m.y0)
+  bucket.mix.dispatch()
+  # Commit Only Touched Tiles
+  bucket.finish()
+
+# ---------------------
+# Bucket Tool Wand Mask
+# ---------------------
+
+proc lanes(bucket: NBucketProof; tx, ty: cint): tuple[full, empty: bool] =
+  let
+    m = bucket.region32(tx, ty)
+    lanes = cast[ptr UncheckedArray[uint32]](bucket.m1)
+    step = bucket.words shl 1
+  result = (m.y1 - m.y0 == 32, true)
+  # Check Tile Fill Lanes
+  var idx = m.y0 * step + tx
+  for _ in m.y0 ..< m.y1:
+    let lane = lanes[idx]
+    result.full = result.full and lane == high(uint32)
+    result.empty = result.empty and lane == 0
+    idx += step
+
+proc wand*(bucket: var NBucketProof; tiles: var NTileImage; x, y: cint) =
+  # Replace Previous Selection
+  tiles.clear()
+  if not bucket.seed(x, y):
+    return
+  let
+    m = bucket.aabb
+    status = bucket.proxy.status
+    # Fill AABB Tile Region
+    tx0 = m.x0 shr 5
+    ty0 = m.y0 shr 5
+    tx1 = (m.x1 + 0x1F) shr 5
+    ty1 = (m.y1 + 0x1F) shr 5
+  tiles.ensure(tx0, ty0, tx1 - tx0, ty1 - ty0)
+  # Store Only Boundary Tiles as Buffers
+  var bits = bucket.bits
+  bits.bounds(32, bucket.words)
+  for ty in ty0 ..< ty1:
+    for tx in tx0 ..< tx1:
+      if not bucket.ready[ty * bucket.w32 + tx]:
+        continue
+      let check = bucket.lanes(tx, ty)
+      if check.empty: continue
+      var tile = tiles.find(tx, ty)
+      if check.full:
+        tile.toColor(high uint64)
+        continue
+      # Unpack Fill Bits to Mask Tile
+      let r = bucket.region32(tx, ty)
+      tile.toBuffer()
+      bits.target(tile.data.buffer, bucket.m1)
+      bits.region(r.x0, r.y0, 32, r.y1 - r.y0)
+      if r.y1 - r.y0 < 32:
+        zeroMem(tile.data.buffer, tile.bytes)
+      bits.toMask()
+      tile.mipmaps()
+  tiles.shrink()
+  # Release Streamed Tiles
+  for idx, ready in pairs(bucket.ready):
+    if ready: status.aux[idx] = 0
+  status.clip = default(NImageMark)
+  bucket.area = mark(0, 0, 0, 0)
@@ -22,6 +22,9 @@ void distance_prepare(distance_t* chamfer);
 void distance_pass0(distance_t* chamfer);
 void distance_pass1(distance_t* chamfer);
 void distance_convert(distance_t* chamfer);
+// Exact Distance Transform
+void distance_exact_cols(distance_t* chamfer, void* aux);
+void distance_exact_rows(distance_t* chamfer, void* aux);
 
 // -------------------
 // Flood Fill Scanline
@@ -78,6 +81,24 @@ void binary_threshold_minimun(binary_t* binary);
 // Binary to Color Convert
 void binary_convert_simple(binary_t* binary);
 
+// ----------------
+// Binary Bit Masks
+// ----------------
+
+typedef struct {
+  // Region Buffer
+  int x, y, w, h;
+  // Binary & Bits Buffer
+  unsigned char* buffer;
+  unsigned long long* bits;
+  // Buffer Strides
+  int stride, words;
+} binary_bits_t;
+
+void binary_pack_bits(binary_bits_t* bits);
+void binary_unpack_bits(binary_bits_t* bits);
+void binary_unpack_mask(binary_bits_t* bits);
+
 // ----------------
 // Binary to Smooth
 // TODO: use binary_t instead
@@ -125,3 +146,19 @@ typedef struct {
 
 void binary_clear(binary_clear_t* clear);
 void binary_stencil(binary_stencil_t* stencil);
+
+// ---------------------
+// Binary Color Blending
+// ---------------------
+
+typedef struct {
+  // Region Buffer
+  int x, y, w, h;
+  // Color Buffers
+  unsigned short* src;
+  unsigned short* dst;
+  // Buffer Stride
+  int stride, rows;
+} binary_blend_t;
+
+void binary_blend(binary_blend_t* blend);
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+#include "binary.h"
+#include <smmintrin.h>
+
+// -------------------
+// Binary Bits Packing
+// -------------------
+
+// Region x must be aligned to 16 pixels
+void binary_pack_bits(binary_bits_t* bits) {
+  int x1, y1, x2, y2;
+  // Packing Region
+  x1 = bits->x;
+  y1 = bits->y;
+  x2 = x1 + bits->w;
+  y2 = y1 + bits->h;
+
+  unsigned char* buffer_row;
+  unsigned short* lanes_row;
+  // Binary Buffer Strides
+  const int buffer_s = bits->stride;
+  const int lanes_s = bits->words << 2;
+  // Locate Buffer Pointers
+  buffer_row = bits->buffer + y1 * buffer_s;
+  lanes_row = (unsigned short*) bits->bits + y1 * lanes_s;
+
+  __m128i xmm0;
+  unsigned int mask;
+  for (int y = y1; y < y2; y++) {
+    for (int x = x1; x < x2; x += 16) {
+      xmm0 = _mm_loadu_si128((__m128i*) (buffer_row + x));
+      mask = _mm_movemask_epi8(xmm0);
+      // Clear Bits Outside Region
+      if (x2 - x < 16)
+        mask &= (1 << (x2 - x)) - 1;
+      // Store 16 Bits Lane
+      lanes_row[x >> 4] = mask;
+    }
+
+    // Next Row
+    buffer_row += buffer_s;
+    lanes_row += lanes_s;
+  }
+}
+
+// ---------------------
+// Binary Bits Unpacking
+// ---------------------
+
+__attribute__((always_inline))
+static inline unsigned char binary_bit(unsigned long long* bits, int x) {
+  return -((bits[x >> 6] >> (x & 63)) & 1);
+}
+
+void binary_unpack_bits(binary_bits_t* bits) {
+  int x1, y1, x2, y2;
+  // Unpacking Region
+  x1 = bits->x;
+  y1 = bits->y;
+  x2 = x1 + bits->w;
+  y2 = y1 + bits->h;
+
+  unsigned char *buffer_row;
+  unsigned long long* bits_row;
+  // Binary Buffer Strides
+  const int buffer_s = bits->stride;
+  const int bits_s = bits->words;
+  // Locate Buffer Pointers
+  buffer_row = bits->buffer + y1 * buffer_s;
+  bits_row = bits->bits + y1 * bits_s;
+
+  __m128i xmm0, select, spread;
+  // Bit Spread for Each Byte
+  spread = _mm_set1_epi64x(0x8040201008040201);
+  select = _mm_set_epi8(1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0);
+  // Lanes View of Bits
+  unsigned short* lanes;
+
+  for (int x, y = y1; y < y2; y++) {
+    lanes = (unsigned short*) bits_row;
+    x = x1;
+
+    // Unpack Unaligned Head
+    for (; (x & 15) && x < x2; x++)
+      buffer_row[x] = binary_bit(bits_row, x);
+    // Unpack 16 Bits Lanes
+    for (; x + 16 <= x2; x += 16) {
+      xmm0 = _mm_set1_epi16(lanes[x >> 4]);
+      xmm0 = _mm_shuffle_epi8(xmm0, select);
+      xmm0 = _mm_and_si128(xmm0, spread);
+      xmm0 = _mm_cmpeq_epi8(xmm0, spread);
+      _mm_storeu_si128((__m128i*) (buffer_row + x), xmm0);
+    }
+
+    // Unpack Remaining Tail
+    for (; x < x2; x++)
+      buffer_row[x] = binary_bit(bits_row, x);
+
+    // Next Row
+    buffer_row += buffer_s;
+    bits_row += bits_s;
+  }
+}
+
+// -----------------------
+// Binary Bits Mask Unpack
+// -----------------------
+
+// Region x and w must be aligned to 16 pixels
+void binary_unpack_mask(binary_bits_t* bits) {
+  const int x1 = bits->x;
+  const int y1 = bits->y;
+  const int w = bits->w;
+  const int h = bits->h;
+
+  unsigned short* mask_row;
+  unsigned short* lanes_row;
+  // Mask Buffer Strides
+  const int mask_s = bits->stride;
+  const int lanes_s = bits->words << 2;
+  // Locate Buffer Pointers
+  mask_row = (unsigned short*) bits->buffer;
+  lanes_row = (unsigned short*) bits->bits + y1 * lanes_s + (x1 >> 4);
+
+  __m128i xmm0, xmm1, lo, hi;
+  // Bit Spread for Each Word
+  lo = _mm_set_epi16(0x80, 0x40, 0x20, 0x10, 0x8, 0x4, 0x2, 0x1);
+  hi = _mm_slli_epi16(lo, 8);
+
+  for (int y = 0; y < h; y++) {
+    // Unpack 16 Bits Lanes to Mask
+    for (int x = 0; x < w; x += 16) {
+      xmm0 = _mm_set1_epi16(lanes_row[x >> 4]);
+      xmm1 = _mm_and_si128(xmm0, hi);
+      xmm0 = _mm_and_si128(xmm0, lo);
+      xmm0 = _mm_cmpeq_epi16(xmm0, lo);
+      xmm1 = _mm_cmpeq_epi16(xmm1, hi);
+      // Store 16 Mask Pixels
+      _mm_storeu_si128((__m128i*) (mask_row + x), xmm0);
+      _mm_storeu_si128((__m128i*) (mask_row + x + 8), xmm1);
+    }
+
+    // Next Row
+    mask_row += mask_s;
+    lanes_row += lanes_s;
+  }
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+#include "binary.h"
+#include <smmintrin.h>
+
+__attribute__((always_inline))
+static inline __m128i _mm_blend_over32(__m128i src, __m128i dst) {
+  const __m128i ones = _mm_set1_epi32(65535);
+  __m128i alpha;
+
+  // Source Alpha Interpolator
+  alpha = _mm_shuffle_epi32(src, 0xFF);
+  alpha = _mm_sub_epi32(ones, alpha);
+  // SRC + (DST * (1 - A_SRC))
+  dst = _mm_mullo_epi32(dst, alpha);
+  dst = _mm_add_epi32(dst, alpha);
+  dst = _mm_srli_epi32(dst, 16);
+
+  return _mm_add_epi32(src, dst);
+}
+
+__attribute__((always_inline))
+static inline __m128i _mm_blend_over16(__m128i src, __m128i dst) {
+  __m128i src0, src1, dst0, dst1;
+
+  // Unpack Two Pixels to 32 bits
+  src0 = _mm_cvtepu16_epi32(src);
+  src1 = _mm_cvtepu16_epi32(_mm_srli_si128(src, 8));
+  dst0 = _mm_cvtepu16_epi32(dst);
+  dst1 = _mm_cvtepu16_epi32(_mm_srli_si128(dst, 8));
+  // Blend Each Pixel
+  dst0 = _mm_blend_over32(src0, dst0);
+  dst1 = _mm_blend_over32(src1, dst1);
+
+  return _mm_packus_epi32(dst0, dst1);
+}
+
+// ---------------------
+// Binary Color Blending
+// ---------------------
+
+void binary_blend(binary_blend_t* blend) {
+  int x1, y1, x2, y2;
+  // Blending Region
+  x1 = blend->x;
+  y1 = blend->y;
+  x2 = x1 + blend->w;
+  y2 = y1 + blend->h;
+
+  unsigned short *src_row, *src;
+  unsigned short *dst_row, *dst;
+  // Color Buffer Stride
+  const int stride = blend->stride << 2;
+  const int index = y1 * stride + (x1 << 2);
+  // Locate Buffer Pointers
+  src_row = blend->src + index;
+  dst_row = blend->dst + index;
+
+  int count, len;
+  // Blending Row
+  len = x2 - x1;
+
+  __m128i xmm0, xmm1;
+  for (int y = y1; y < y2; y++) {
+    src = src_row;
+    dst = dst_row;
+    // Row Length
+    count = len;
+
+    while (count > 0) {
+      // Load Two Pixels
+      if (__builtin_expect(count >= 2, 1)) {
+        xmm0 = _mm_loadu_si128((__m128i*) src);
+        xmm1 = _mm_loadu_si128((__m128i*) dst);
+      } else {
+        xmm0 = _mm_loadl_epi64((__m128i*) src);
+        xmm1 = _mm_loadl_epi64((__m128i*) dst);
+      }
+
+      // Skip Transparent Pixels
+      if (!_mm_testz_si128(xmm0, xmm0)) {
+        xmm1 = _mm_blend_over16(xmm0, xmm1);
+        // Store Blended Pixels
+        if (count >= 2)
+          _mm_storeu_si128((__m128i*) dst, xmm1);
+        else _mm_storel_epi64((__m128i*) dst, xmm1);
+      }
+
+      // Two Pixels
+      src += 8;
+      dst += 8;
+      // Two Count
+      count -= 2;
+    }
+
+    // Next Row
+    src_row += stride;
+    dst_row += stride;
+  }
+}
@@ -257,6 +257,7 @@ void binary_convert_smooth(binary_smooth_t* smooth) {
   const int gray_s = smooth->stride;
   const int color_s = gray_s << 2;
   color_row += y1 * color_s + (x1 << 2);
+  gray_row += y1 * gray_s + x1;
 
   __m128i xmm0, xmm1, xmm2;
   // Color Conversion
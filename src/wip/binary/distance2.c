@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+#include "binary.h"
+#include <math.h>
+
+// ----------------------------------
+// Exact Distance Transform: Envelope
+// ----------------------------------
+
+static void distance_exact_line(unsigned int* line, int n, int step, void* aux) {
+  const unsigned int infinite = 2147483647;
+  // Lower Envelope Auxiliars
+  unsigned int* f = aux;
+  int* v = (int*) (f + n);
+  double* z = (double*) (v + n);
+  double s = 0.0;
+  int k = -1;
+
+  // Copy Line Distances
+  for (int q = 0; q < n; q++)
+    f[q] = line[q * step];
+
+  // Calculate Lower Envelope of Parabolas
+  for (int q = 0; q < n; q++) {
+    if (f[q] == infinite)
+      continue;
+
+    while (k >= 0) {
+      const int p = v[k];
+      // Intersection With Last Parabola
+      s = ((double) f[q] + q * q) - ((double) f[p] + p * p);
+      s /= 2.0 * (q - p);
+      if (s > z[k]) break;
+      k--;
+    }
+
+    // Add Parabola to Envelope
+    k++;
+    v[k] = q;
+    z[k] = (k > 0) ? s : -INFINITY;
+  }
+
+  // Line Without Features
+  if (k < 0) return;
+  // Evaluate Lower Envelope
+  for (int j = 0, q = 0; q < n; q++) {
+    while (j < k && z[j + 1] < q)
+      j++;
+    // Store Squared Distance
+    const int d = q - v[j];
+    line[q * step] = d * d + f[v[j]];
+  }
+}
+
+// --------------------------------
+// Exact Distance Transform: Passes
+// --------------------------------
+
+void distance_exact_cols(distance_t* chamfer, void* aux) {
+  int x1, y1, x2;
+  // Locate Position
+  x1 = chamfer->x;
+  y1 = chamfer->y;
+  x2 = x1 + chamfer->w;
+
+  const int stride = chamfer->stride;
+  const int rows = chamfer->h;
+  // Locate Distances Pointer
+  unsigned int* distances;
+  distances = chamfer->distances + y1 * stride;
+
+  // Calculate Each Column
+  for (int x = x1; x < x2; x++)
+    distance_exact_line(distances + x, rows, stride, aux);
+}
+
+void distance_exact_rows(distance_t* chamfer, void* aux) {
+  int x1, y1, y2;
+  // Locate Position
+  x1 = chamfer->x;
+  y1 = chamfer->y;
+  y2 = y1 + chamfer->h;
+
+  const int stride = chamfer->stride;
+  const int cols = chamfer->w;
+  // Locate Distances Pointer
+  unsigned int* distances;
+  distances = chamfer->distances + y1 * stride + x1;
+
+  // Calculate Each Row
+  for (int y = y1; y < y2; y++) {
+    distance_exact_line(distances, cols, 1, aux);
+    distances += stride;
+  }
+}
@@ -7,7 +7,10 @@
 {.compile: "floodfill1.c".}
 {.compile: "distance0.c".}
 {.compile: "distance1.c".}
+{.compile: "distance2.c".}
 {.compile: "smooth.c".}
+{.compile: "blend.c".}
+{.compile: "bits.c".}
 # ----------------------
 {.push header: "wip/binary/binary.h".}
 
@@ -44,6 +47,14 @@ type
     # Color <-> Binary
     value, threshold: cuint
     rgba, check: cuint
+  NBinaryBits* {.importc: "binary_bits_t".} = object
+    # Region Buffer
+    x, y, w, h: cint
+    # Binary & Bits Buffer
+    buffer: pointer
+    bits: ptr uint64
+    # Buffer Strides
+    stride, words: cint
   NBinarySmooth* {.importc: "binary_smooth_t".} = object
     x, y, w, h: cint
     # Buffer Pointers
@@ -63,7 +74,17 @@ type
     buffer: pointer
     # Buffer Stride & Size
     stride, bytes: cint
-    
+  # ---------------
+  # Binary Blending
+  # ---------------
+  NBinaryBlend* {.importc: "binary_blend_t".} = object
+    # Region Buffer
+    x, y, w, h: cint
+    # Color Buffers
+    src, dst: pointer
+    # Buffer Stride
+    stride, rows: cint
+
 
 {.push importc.}
 
@@ -71,6 +92,8 @@ proc distance_prepare(chamfer: ptr NDistance)
 proc distance_pass0(chamfer: ptr NDistance)
 proc distance_pass1(chamfer: ptr NDistance)
 proc distance_convert(chamfer: ptr NDistance)
+proc distance_exact_cols(chamfer: ptr NDistance, aux: pointer)
+proc distance_exact_rows(chamfer: ptr NDistance, aux: pointer)
 # Flood Fill Procs
 proc floodfill_simple(flood: ptr NFloodFill)
 proc floodfill_dual(flood: ptr NFloodFill)
@@ -81,12 +104,18 @@ proc binary_threshold_alpha(binary: ptr NBinary)
 proc binary_threshold_minimun(binary: ptr NBinary)
 # Binary to Color Convert
 proc binary_convert_simple(binary: ptr NBinary)
+# Binary Bit Masks
+proc binary_pack_bits(bits: ptr NBinaryBits)
+proc binary_unpack_bits(bits: ptr NBinaryBits)
+proc binary_unpack_mask(bits: ptr NBinaryBits)
 proc binary_smooth_dilate(smooth: ptr NBinarySmooth)
 proc binary_smooth_magic(smooth: ptr NBinarySmooth)
 proc binary_smooth_apply(smooth: ptr NBinarySmooth)
 proc binary_convert_smooth(binary: ptr NBinarySmooth)
 # Binary Clearing Fill
 proc binary_clear(clear: ptr NBinaryClear)
+# Binary Color Blending
+proc binary_blend(blend: ptr NBinaryBlend)
 
 {.pop.} # End importc
 {.pop.} # End header
@@ -131,6 +160,14 @@ proc dispatch_full*(chamfer: var NDistance) =
   distance_pass1(addr chamfer)
   distance_convert(addr chamfer)
 
+proc dispatch_cols*(chamfer: var NDistance, aux: pointer) =
+  distance_prepare(addr chamfer)
+  distance_exact_cols(addr chamfer, aux)
+
+proc dispatch_rows*(chamfer: var NDistance, aux: pointer) =
+  distance_exact_rows(addr chamfer, aux)
+  distance_convert(addr chamfer)
+
 # -------------------
 # Flood Fill Scanline
 # -------------------
@@ -154,6 +191,9 @@ proc dispatch*(flood: var NFloodFill; x, y: cint; dual: bool) =
   if dual: floodfill_dual(addr flood)
   else: floodfill_simple(addr flood)
 
+proc aabb*(flood: NFloodFill): tuple[x1, y1, x2, y2: cint] =
+  result = (flood.x1, flood.y1, flood.x2, flood.y2)
+
 # -----------------
 # Binary Conversion
 # -----------------
@@ -194,6 +234,34 @@ proc toColor*(binary: var NBinary; rgba, check: cuint) =
   # Dispath to Color
   binary_convert_simple(addr binary)
 
+# ----------------
+# Binary Bit Masks
+# ----------------
+
+proc target*(bits: var NBinaryBits; buffer, words: pointer) =
+  bits.buffer = buffer
+  bits.bits = cast[ptr uint64](words)
+
+proc bounds*(bits: var NBinaryBits; stride, words: cint) =
+  bits.stride = stride
+  bits.words = words
+
+proc region*(bits: var NBinaryBits; x, y, w, h: cint) =
+  bits.x = x
+  bits.y = y
+  # Bits Region
+  bits.w = w
+  bits.h = h
+
+proc pack*(bits: var NBinaryBits) =
+  binary_pack_bits(addr bits)
+
+proc unpack*(bits: var NBinaryBits) =
+  binary_unpack_bits(addr bits)
+
+proc toMask*(bits: var NBinaryBits) =
+  binary_unpack_mask(addr bits)
+
 # ------------------------
 # Binary Smooth Conversion
 # TODO: Use NBinary instead
@@ -218,6 +286,25 @@ proc toSmooth*(smooth: var NBinarySmooth, binary: var NBinary; rgba, check: cuin
 proc auxiliar*(smooth: var NBinarySmooth, gray: ptr cushort) =
   smooth.gray = gray
 
+proc region*(smooth: var NBinarySmooth; x, y, w, h: cint) =
+  smooth.x = x
+  smooth.y = y
+  # Smooth Region
+  smooth.w = w
+  smooth.h = h
+
+proc dilate*(smooth: var NBinarySmooth) =
+  binary_smooth_dilate(addr smooth)
+
+proc magic*(smooth: var NBinarySmooth) =
+  binary_smooth_magic(addr smooth)
+
+proc apply*(smooth: var NBinarySmooth) =
+  binary_smooth_apply(addr smooth)
+
+proc convert*(smooth: var NBinarySmooth) =
+  binary_convert_smooth(addr smooth)
+
 proc dispatch*(smooth: var NBinarySmooth) =
   let p = addr smooth
   binary_smooth_dilate(p)
@@ -245,3 +332,25 @@ proc region*(clear: var NBinaryClear; x, y, w, h: cint) =
 
 proc dispatch*(clear: var NBinaryClear) =
   binary_clear(addr clear)
+
+# ---------------------
+# Binary Color Blending
+# ---------------------
+
+proc target*(blend: var NBinaryBlend; src, dst: pointer) =
+  blend.src = src
+  blend.dst = dst
+
+proc bounds*(blend: var NBinaryBlend; stride, rows: cint) =
+  blend.stride = stride
+  blend.rows = rows
+
+proc region*(blend: var NBinaryBlend; x, y, w, h: cint) =
+  blend.x = x
+  blend.y = y
+  # Blending Region
+  blend.w = w
+  blend.h = h
+
+proc dispatch*(blend: var NBinaryBlend) =
+  binary_blend(addr blend)
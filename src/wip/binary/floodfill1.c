@@ -255,5 +255,16 @@ void floodfill_dual(floodfill_t* flood) {
     // Calculate Scanline
     scanline_dual_right(&scan);
     scanline_dual_left(&scan);
+    // Check Vertical Boundaries
+    if (scan.y < scan.y1)
+      scan.y1 = scan.y;
+    if (scan.y > scan.y2)
+      scan.y2 = scan.y;
   }
+
+  // Store Scanline AABB
+  flood->x1 = scan.x1 + 1;
+  flood->y1 = scan.y1;
+  flood->x2 = scan.x2;
+  flood->y2 = scan.y2 + 1;
 }
@@ -30,6 +30,29 @@ static unsigned char binary_pixel_clamp(int x, int y, int w, int h) {
   return mask;
 }
 
+static inline unsigned char binary_row_clamp(int y, int h) {
+  unsigned char mask = 0;
+  // Check Vertical Bounds
+  if (y <= 0) mask |= 0x83;
+  if (y >= h - 1) mask |= 0x38;
+
+  return mask;
+}
+
+static inline void binary_interior(binary_smooth_t* smooth, int* xa, int* xb) {
+  const int x1 = smooth->x;
+  const int x2 = x1 + smooth->w;
+  const int stride = smooth->stride;
+  // Columns Without Horizontal Clamp
+  int a = (x1 > 1) ? x1 : 1;
+  int b = (x2 < stride - 1) ? x2 : stride - 1;
+  if (a > x2) a = x2;
+  if (b < a) b = a;
+  // Return Interior
+  *xa = a;
+  *xb = b;
+}
+
 // -------------------------
 // Binary Dilate Calculation
 // -------------------------
@@ -56,49 +79,46 @@ static unsigned short binary_pixel_dilate(binary_smooth_t* smooth, int x, int y,
   return mask >> 1;
 }
 
-void binary_smooth_dilate(binary_smooth_t* smooth) {
-  int x1, y1, x2, y2;
-  // Rendering Region
-  x1 = smooth->x;
-  y1 = smooth->y;
-  x2 = x1 + smooth->w;
-  y2 = y1 + smooth->h;
-
-  // Magic Buffer Pointer
-  unsigned char *magic, *magic_row;
-  unsigned char *binary, *binary_row;
-  // Gray Buffer Pointer
-  unsigned short *gray, *gray_row;
-
+__attribute__((always_inline))
+static inline void binary_dilate_span(binary_smooth_t* smooth, int x1, int x2, int y, int border) {
   const int stride = smooth->stride;
   const int rows = smooth->rows;
   // Current Binary Check
   const unsigned int check = smooth->check;
-  // Locate Magic Buffer Pointer
-  const int index = y1 * stride + x1;
-  binary_row = smooth->binary + index;
-  gray_row = smooth->gray + index;
+  // Locate Buffer Pointers
+  const int index = y * stride + x1;
+  unsigned char* binary = smooth->binary + index;
+  unsigned short* gray = smooth->gray + index;
   // Current Boundary Clamp
-  unsigned char clamp;
+  unsigned char clamp = binary_row_clamp(y, rows);
 
-  // Iterate Each Pixel
-  for (int y = y1; y < y2; y++) {
-    binary = binary_row;
-    gray = gray_row;
-
-    for (int x = x1; x < x2; x++) {
-      // Get Current Clamp And Calculate Pixel
+  for (int x = x1; x < x2; x++) {
+    // Clamp Columns Only at Borders
+    if (border)
       clamp = binary_pixel_clamp(x, y, stride, rows);
-      *gray = (*binary == check) ? 0x7FFF : binary_pixel_dilate(smooth, x, y - 1, check, clamp);
+    *gray = (*binary == check) ? 0x7FFF : binary_pixel_dilate(smooth, x, y - 1, check, clamp);
 
-      // Step Binary
-      binary++;
-      gray++;
-    }
+    // Step Binary
+    binary++;
+    gray++;
+  }
+}
 
-    // Step Stride
-    binary_row += stride;
-    gray_row += stride;
+void binary_smooth_dilate(binary_smooth_t* smooth) {
+  int x1, y1, x2, y2, xa, xb;
+  // Rendering Region
+  x1 = smooth->x;
+  y1 = smooth->y;
+  x2 = x1 + smooth->w;
+  y2 = y1 + smooth->h;
+  // Unchecked Interior Columns
+  binary_interior(smooth, &xa, &xb);
+
+  // Iterate Each Row
+  for (int y = y1; y < y2; y++) {
+    binary_dilate_span(smooth, x1, xa, y, 1);
+    binary_dilate_span(smooth, xa, xb, y, 0);
+    binary_dilate_span(smooth, xb, x2, y, 1);
   }
 }
 
@@ -131,49 +151,49 @@ static unsigned char binary_pixel_magic(binary_smooth_t* smooth, int x, int y, u
   return magic_numbers[mask | clamp];
 }
 
-void binary_smooth_magic(binary_smooth_t* smooth) {
-  int x1, y1, x2, y2;
-  // Rendering Region
-  x1 = smooth->x;
-  y1 = smooth->y;
-  x2 = x1 + smooth->w;
-  y2 = y1 + smooth->h;
-
-  // Magic Buffer & Gray Pointer
-  unsigned char *binary, *binary_row;
-  unsigned short *gray, *gray_row;
-  // Buffer Stride Size
+__attribute__((always_inline))
+static inline void binary_magic_span(binary_smooth_t* smooth, int x1, int x2, int y, int border) {
   const int stride = smooth->stride;
   const int rows = smooth->rows;
-  // Locate Magic Buffer Pointer
-  const int index = y1 * stride + x1;
-  binary_row = smooth->binary + index;
-  gray_row = smooth->gray + index;
   // Binary Selected Check
   const unsigned int check = smooth->check;
+  // Locate Buffer Pointers
+  const int index = y * stride + x1;
+  unsigned char* binary = smooth->binary + index;
+  unsigned short* gray = smooth->gray + index;
   // Current Boundary Clamp
+  const unsigned char row = binary_row_clamp(y, rows);
   unsigned char clamp;
 
-  // Iterate Each Pixel
-  for (int y = y1; y < y2; y++) {
-    binary = binary_row;
-    gray = gray_row;
+  for (int x = x1; x < x2; x++) {
+    if (clamp = (*gray && *binary != check)) {
+      // Clamp Columns Only at Borders
+      clamp = (border) ? binary_pixel_clamp(x, y, stride, rows) : row;
+      clamp = binary_pixel_magic(smooth, x, y - 1, clamp);
+    }
 
-    for (int x = x1; x < x2; x++) {
-      if (clamp = (*gray && *binary != check)) {
-        clamp = binary_pixel_clamp(x, y, stride, rows);
-        clamp = binary_pixel_magic(smooth, x, y - 1, clamp);
-      }
+    *binary = clamp;
+    // Step Binary
+    binary++;
+    gray++;
+  }
+}
 
-      *binary = clamp;
-      // Step Binary
-      binary++;
-      gray++;
-    }
+void binary_smooth_magic(binary_smooth_t* smooth) {
+  int x1, y1, x2, y2, xa, xb;
+  // Rendering Region
+  x1 = smooth->x;
+  y1 = smooth->y;
+  x2 = x1 + smooth->w;
+  y2 = y1 + smooth->h;
+  // Unchecked Interior Columns
+  binary_interior(smooth, &xa, &xb);
 
-    // Step Stride
-    binary_row += stride;
-    gray_row += stride;
+  // Iterate Each Row
+  for (int y = y1; y < y2; y++) {
+    binary_magic_span(smooth, x1, xa, y, 1);
+    binary_magic_span(smooth, xa, xb, y, 0);
+    binary_magic_span(smooth, xb, x2, y, 1);
   }
 }
 
@@ -181,6 +201,20 @@ void binary_smooth_magic(binary_smooth_t* smooth) {
 // Binary Smooth Line DDA
 // ----------------------
 
+__attribute__((always_inline))
+static inline void binary_pixel_store(unsigned short* gray, unsigned short lopixel, int high) {
+  unsigned short pixel = __atomic_load_n(gray, __ATOMIC_RELAXED);
+  // Commutative Max or Min Store
+  do {
+    if (high) {
+      if (pixel != 0x7FFF && lopixel <= pixel)
+        return;
+    } else if (lopixel >= pixel)
+      return;
+  } while (!__atomic_compare_exchange_n(gray, &pixel, lopixel,
+    1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
 static void binary_pixel_dda(binary_smooth_t* smooth, int x, int y, int check, int offset) {
   offset <<= 1;
   // Load DDA Offsets
@@ -226,7 +260,7 @@ static void binary_pixel_dda(binary_smooth_t* smooth, int x, int y, int check, i
       dda_current = dda_step + 0x7FFF0000;
     }
 
-    unsigned short pixel, lopixel;
+    unsigned short lopixel;
     unsigned short* gray;
     // Locate Buffer Pointers
     aux = y * stride + x;
@@ -234,16 +268,12 @@ static void binary_pixel_dda(binary_smooth_t* smooth, int x, int y, int check, i
     magic = smooth->binary + aux;
 
     while (count > 0) {
-      pixel = *gray;
       aux = *magic;
       // Calculate Current Smooth
       lopixel = (unsigned short) (dda_current >> 16);
 
-      if ((aux & 0xC0) == 0xC0) {
-        if (pixel == 0x7FFF || lopixel > pixel)
-          *gray = lopixel;
-      } else if (lopixel < pixel)
-        *gray = lopixel;
+      // Bands Share Pixels Across Borders
+      binary_pixel_store(gray, lopixel, (aux & 0xC0) == 0xC0);
       
       // Step DDA
       dda_current += dda_step;
@@ -14,9 +14,14 @@ from math import
   sin, cos, arctan2
 # Import 2PI Constant
 const pi2 = 6.283185307179586
+# Predicted Dabs Lifetime in Nanoseconds
+const specExpire = 32_000_000
 # Import Scattering
 from random import 
   Rand, gauss, initRand
+# Import Profiling
+from std/monotimes import
+  getMonoTime, ticks
 # Export Brush Pipeline Kinds
 export NBrushShape, NBrushBlend
 
@@ -129,6 +134,25 @@ type
     avg*: NStrokeAverage
     marker*: NStrokeMarker
     blur*: NStrokeBlur
+  # -----------------------
+  NStrokeSpeculate = object
+    a, b, ahead: NStrokePoint
+    ready, active: bool
+    time: int64
+    # Stroke State Snapshot
+    prev_t: float32
+    generic: NStrokeGeneric
+    data: NStrokeBlend
+    pipe: NBrushSnapshot
+    # Proxy Tiles Backup
+    tiles: seq[tuple[tx, ty: cint]]
+    pixels: seq[uint64]
+  # ----------------------
+  NBrushProfile* = object
+    dabs*: int
+    # Accumulated Nanoseconds
+    stage0*, stage1*: int64
+    stream*: int64
   # ---------------------
   NBrushStroke* = object
     # Shape & Blend Kind
@@ -146,10 +170,27 @@ type
     generic: NStrokeGeneric
     points: Deque[NStrokePoint]
     a, b: NStrokePoint
+    spec: NStrokeSpeculate
+    # Segment Discovery
+    found: NStrokeRegion
+    reach: NStrokePoint
     # --TEMPORALY PUBLIC--
     # Brush Engine Pipeline
     pipe*: NBrushPipeline
     proxy*: ptr NImageProxy
+    profile*: ptr NBrushProfile
+
+# ----------------------
+# BRUSH STROKE PROFILING
+# ----------------------
+
+template measure(path: var NBrushStroke, field, body: untyped) =
+  let profile = path.profile
+  if isNil(profile): body
+  else: # Accumulate Elapsed Time
+    let t0 = ticks getMonoTime()
+    body
+    profile.field += ticks(getMonoTime()) - t0
 
 # ----------------------
 # BRUSH STROKE PREPARING
@@ -158,6 +199,12 @@ type
 proc clear*(path: var NBrushStroke) =
   path.prev_t = 0.0
   clear(path.points)
+  # Discard Speculation
+  let spec = addr path.spec
+  setLen(spec.tiles, 0)
+  setLen(spec.pixels, 0)
+  spec.ready = false
+  spec.active = false
 
 proc color*(path: var NBrushStroke, r, g, b: cint, glass: bool) =
   if not glass:
@@ -327,9 +374,84 @@ proc region(x, y, size, angle: cfloat): NStrokeRegion =
   result.x2 = ceil(x + w).cint
   result.y2 = ceil(y + h).cint
 
+# -------------------------------
+# BRUSH STROKE SPECULATIVE BACKUP
+# -------------------------------
+
+proc copy(path: var NBrushStroke, idx: int, store: bool) =
+  let
+    spec = addr path.spec
+    canvas = addr path.pipe.canvas
+    tile = spec.tiles[idx]
+    # Tile Region Clipped
+    x0 = tile.tx shl 5
+    y0 = tile.ty shl 5
+    w = min(canvas.w - x0, 32)
+    h = min(canvas.h - y0, 32)
+    stride = canvas.stride
+    # Tile Buffer Pointers
+    dst = cast[ptr UncheckedArray[uint64]](canvas.dst)
+    pixels = cast[ptr UncheckedArray[uint64]](addr spec.pixels[idx shl 10])
+  # Copy Tile Rows
+  for y in 0 ..< h:
+    let
+      row = addr dst[(y0 + y) * stride + x0]
+      bak = addr pixels[y shl 5]
+    if store: copyMem(bak, row, w * sizeof(uint64))
+    else: copyMem(row, bak, w * sizeof(uint64))
+
+proc backup(path: var NBrushStroke, r: NStrokeRegion) =
+  let
+    spec = addr path.spec
+    canvas = addr path.pipe.canvas
+    # Clipped Region
+    x1 = max(r.x1, 0)
+    y1 = max(r.y1, 0)
+    x2 = min(r.x2, canvas.w)
+    y2 = min(r.y2, canvas.h)
+  if x1 >= x2 or y1 >= y2:
+    return
+  # Store Untouched Tiles
+  for ty in y1 shr 5 .. (y2 - 1) shr 5:
+    for tx in x1 shr 5 .. (x2 - 1) shr 5:
+      if (tx, ty) in spec.tiles:
+        continue
+      spec.tiles.add (tx, ty)
+      setLen(spec.pixels, len(spec.pixels) + 1024)
+      path.copy(high spec.tiles, store = true)
+
 proc discover(path: var NBrushStroke, r: NStrokeRegion) =
-  path.proxy[].mark(r.x1, r.y1, r.x2 - r.x1, r.y2 - r.y1)
-  path.proxy[].stream()
+  let f = addr path.found
+  # Skip Already Discovered
+  if r.x1 >= f.x1 and r.y1 >= f.y1 and
+      r.x2 <= f.x2 and r.y2 <= f.y2:
+    return
+  let
+    dyn = addr path.generic
+    # Sweep Limit to Region Size
+    limit = cfloat max(r.x2 - r.x1, r.y2 - r.y1)
+  # Remaining Segment Distance
+  var
+    dx = path.reach.x - dyn.x
+    dy = path.reach.y - dyn.y
+  let dist = sqrt(dx * dx + dy * dy)
+  # Clamp Sweep Distance
+  if dist > limit:
+    let t = limit / dist
+    dx *= t; dy *= t
+  # Sweep Region Ahead
+  var u = r
+  u.x1 = min(r.x1, r.x1 + floor(dx).cint)
+  u.y1 = min(r.y1, r.y1 + floor(dy).cint)
+  u.x2 = max(r.x2, r.x2 + ceil(dx).cint)
+  u.y2 = max(r.y2, r.y2 + ceil(dy).cint)
+  # Discover Swept Region
+  path.proxy[].mark(u.x1, u.y1, u.x2 - u.x1, u.y2 - u.y1)
+  path.measure(stream): path.proxy[].stream()
+  f[] = u
+  # Backup Predicted Region
+  if path.spec.active:
+    path.backup(u)
 
 # --------------------------------------
 # BRUSH STROKE PER SHAPE RENDERING PROCS
@@ -363,6 +485,7 @@ proc prepare_stage0(path: var NBrushStroke, dyn: ptr NStrokeGeneric) =
     # Configure Circle
     basic(mask.circle, x, y, size)
     style(mask.circle, hard, sharp)
+    path.pipe.stamp(hard, sharp)
     # Configure Blotmap
     if path.shape == bsBlotmap:
       let
@@ -393,10 +516,13 @@ proc prepare_stage0(path: var NBrushStroke, dyn: ptr NStrokeGeneric) =
       x1 = x + r0 * s_space
       y1 = y + r1 * s_space
       # Scatter Angle / Scale
-      a1 = pi2 * (b.angle + s_angle + angle)
-      s1 = max(size * b.scale * s_scale, 1.0)
+      a0 = pi2 * (b.angle + s_angle + angle)
+      s0 = max(size * b.scale * s_scale, 1.0)
+      # Quantize to Cached Stamps
+      a1 = path.pipe.stamps.angle(a0)
+      s1 = path.pipe.stamps.scale(s0)
       # Bitmap Aspect Ratio
-      wh = 2.0 * b.aspect - 1.0
+      wh = path.pipe.stamps.aspect(2.0 * b.aspect - 1.0)
     # Configure Bitmap Buffer
     var
       offset: cfloat
@@ -412,6 +538,7 @@ proc prepare_stage0(path: var NBrushStroke, dyn: ptr NStrokeGeneric) =
     offset *= 2.0
     # Configure Bitmap Affine
     affine(mask.bitmap, x1, y1, a1)
+    path.pipe.stamp(mip.serial, mip.level, x1, y1, a1, s1, wh)
     # Calculare Brush Bitmap Region
     r = region(x1, y1, s1 + offset, a1)
   # Pipeline Stage Texture
@@ -531,12 +658,15 @@ proc prepare_stage1(path: var NBrushStroke, press: cfloat): bool =
 proc stage(path: var NBrushStroke; dyn: ptr NStrokeGeneric; press: cfloat) =
   # Pipeline Stage 0
   prepare_stage0(path, dyn)
-  dispatch_stage0(path.pipe)
+  path.measure(stage0): dispatch_stage0(path.pipe)
   # Pipeline Stage 1
   if prepare_stage1(path, press):
-    dispatch_stage1(path.pipe)
+    path.measure(stage1): dispatch_stage1(path.pipe)
   # Pipeline Stage Skip
   path.pipe.skip = false
+  # Pipeline Stage Count
+  if not isNil(path.profile):
+    inc(path.profile.dabs)
 
 # --------------------------
 # BRUSH STROKE PATH DISPATCH
@@ -611,6 +741,9 @@ proc line(path: var NBrushStroke, a, b: NStrokePoint, start: cfloat): cfloat =
   # Avoid Zero Length
   if length < 0.0001:
     return start
+  # Reset Segment Discovery
+  path.found = default(NStrokeRegion)
+  path.reach = b
   let
     # Stroke Shape Step
     step = path.step
@@ -696,6 +829,69 @@ proc skip*(path: var NBrushStroke) =
   let a = NStrokePoint(press: 2.0)
   path.points.addLast(a)
 
+# -----------------------------
+# BRUSH STROKE SPECULATIVE DABS
+# -----------------------------
+
+proc predict*(path: var NBrushStroke; x, y, press: cfloat) =
+  let spec = addr path.spec
+  # Store Predicted Point
+  spec.ahead.x = x
+  spec.ahead.y = y
+  spec.ahead.press = max(press, 0.0001)
+  spec.ready = true
+
+proc predicted*(path: var NBrushStroke): bool =
+  let spec = addr path.spec
+  # Check Stroke Caught Up
+  if not spec.ready or len(path.points) != 1:
+    return false
+  let a = path.points[0]
+  if a.press == 2.0 or a.angle > 1.0:
+    return false
+  # Prepare Predicted Line
+  spec.a = a
+  spec.b = spec.ahead
+  spec.b.angle = a.angle
+  spec.ready = false
+  result = true
+
+proc speculate*(path: var NBrushStroke) =
+  let spec = addr path.spec
+  # Snapshot Stroke State
+  spec.prev_t = path.prev_t
+  spec.generic = path.generic
+  spec.data = path.data
+  spec.pipe = path.pipe.snapshot()
+  spec.time = ticks getMonoTime()
+  spec.active = true
+  # Render Predicted Line
+  discard path.line(spec.a, spec.b, path.prev_t)
+
+proc expired*(path: var NBrushStroke): bool =
+  let spec = addr path.spec
+  # Check Predicted Dabs Without New Input
+  if spec.active:
+    let elapsed = ticks(getMonoTime()) - spec.time
+    result = elapsed > specExpire
+
+proc rollback*(path: var NBrushStroke) =
+  let spec = addr path.spec
+  if not spec.active:
+    return
+  # Restore Proxy Tiles
+  for idx, tile in pairs(spec.tiles):
+    path.copy(idx, store = false)
+    path.proxy[].mark(tile.tx shl 5, tile.ty shl 5, 32, 32)
+  setLen(spec.tiles, 0)
+  setLen(spec.pixels, 0)
+  # Restore Stroke State
+  path.prev_t = spec.prev_t
+  path.generic = spec.generic
+  path.data = spec.data
+  path.pipe.restore(spec.pipe)
+  spec.active = false
+
 # -------------------
 # Small State Machine
 # -------------------
@@ -726,5 +922,7 @@ proc take*(path: var NBrushStroke): bool =
     l = len(path.points)
 
 proc dispatch*(path: var NBrushStroke) =
+  # Discard Predicted Dabs
+  path.rollback()
   path.prev_t = path.line(
     path.a, path.b, path.prev_t)
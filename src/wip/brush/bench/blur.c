@@ -0,0 +1,417 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+#include "../brush.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// ------------------------------
+// BASELINE LINEAR BLUR REFERENCE
+// ------------------------------
+
+typedef struct {
+  // Region Pointer With Offset
+  short *buffer, *mask;
+  // Region Stride
+  int s_buffer, s_mask;
+  // Region Size
+  int w, h;
+} ref_region_t;
+
+typedef struct {
+  // Convolve Area
+  int x1, x2, y1, y2;
+} ref_convolve_t;
+
+// Exact Float Tent Toggle
+static int ref_exact;
+
+static unsigned int _mm_linear_65535(const int s, unsigned int x) {
+  const int c = (int) x;
+  if (c < 0) x = -c;
+
+  x >>= s;
+  // Linear Weight
+  if (x > 65536) x = 65536;
+  x = (65536 - x) >> s;
+
+  // Return Weight
+  return x;
+}
+
+#define CLAMP(x, a, b) (x < a) ? a : ((x > b) ? b : x)
+
+static void ref_blur_locate(ref_region_t* r, ref_convolve_t* c, int u0, int v0, int size) {
+  const int w = r->w;
+  const int h = r->h;
+
+  // Locate Pixel
+  u0 >>= 16;
+  v0 >>= 16;
+  // Locate Convolution Offset
+  const int o0 = (size >> 1) - 1;
+
+  int stride;
+  // Convolution Region
+  int x1 = u0 - o0;
+  int y1 = v0 - o0;
+  int x2 = x1 + size;
+  int y2 = y1 + size;
+
+  // Clamp Convolution Region
+  x1 = CLAMP(x1, 0, w);
+  x2 = CLAMP(x2, 0, w);
+  y1 = CLAMP(y1, 0, h);
+  y2 = CLAMP(y2, 0, h);
+
+  stride = (y1 * r->s_mask + x1);
+  // Apply Offset to Buffer
+  r->mask += stride;
+  r->buffer += stride << 2;
+
+  // Convolve Area
+  c->x1 = x1 - u0;
+  c->y1 = y1 - v0;
+  c->x2 = x2 - u0;
+  c->y2 = y2 - v0;
+
+  stride = x2 - x1;
+  // Ajust Stride to Size
+  r->s_mask -= stride;
+  r->s_buffer -= stride << 2;
+}
+
+static __m128i ref_blur_linear(ref_region_t r, const int s, int u, int v) {
+  // Initial Position
+  const int u0 = u & ~0xFFFF;
+  const int v0 = v & ~0xFFFF;
+
+  // Convolution Area Size
+  const int size = 1 << (s + 1);
+  const int scaler = 24 - s;
+
+  ref_convolve_t c;
+  // Locate Convolution Region
+  ref_blur_locate(&r, &c, u0, v0, size);
+
+  __m128i xmm0, xmm1, xmm2;
+  // Initialize Pixel Accumulator
+  xmm0 = _mm_setzero_si128();
+  int count = 0, vj, ui;
+  unsigned int w, w_row;
+
+  for (int j = c.y1; j < c.y2; j++) {
+    vj = v - v0 - (j << 16);
+    w_row = _mm_linear_65535(s, vj);
+
+    for (int i = c.x1; i < c.x2; i++) {
+      ui = u - u0 - (i << 16);
+      w = _mm_linear_65535(s, ui);
+      // Calculate Y * X Weight
+      w = (w_row * w) >> scaler;
+
+      if (w > 0 && *r.mask) {
+        // Load Current Weight Pixel
+        xmm1 = _mm_loadl_epi64((__m128i*) r.buffer);
+        xmm1 = _mm_cvtepu16_epi32(xmm1);
+        // Load Four Weights
+        xmm2 = _mm_cvtsi32_si128(w);
+        xmm2 = _mm_shuffle_epi32(xmm2, 0);
+
+        // Count Current Pixel
+        xmm1 = _mm_mullo_epi32(xmm1, xmm2);
+        xmm0 = _mm_add_epi32(xmm0, xmm1);
+        // Count Current Weight
+        count += w;
+      }
+
+      // Step Pixel
+      r.mask++;
+      r.buffer += 4;
+    }
+
+    // Step Stride
+    r.mask += r.s_mask;
+    r.buffer += r.s_buffer;
+  }
+
+  if (count > 0) {
+    __m128 rcp, avg;
+    // Load Four Counts
+    xmm1 = _mm_cvtsi32_si128(count);
+    xmm1 = _mm_shuffle_epi32(xmm1, 0);
+    // Convert to Float
+    avg = _mm_cvtepi32_ps(xmm0);
+    rcp = _mm_cvtepi32_ps(xmm1);
+    // Apply Division
+    rcp = _mm_rcp_ps(rcp);
+    avg = _mm_mul_ps(avg, rcp);
+
+    // Convert Back to Integer
+    xmm0 = _mm_cvtps_epi32(avg);
+    xmm0 = _mm_srli_epi32(xmm0, 1);
+  } else if (count == 0) {
+    xmm0 = _mm_cmpeq_epi32(xmm0, xmm0);
+  }
+
+  return xmm0;
+}
+
+static __m128i ref_blur_exact(ref_region_t r, const int s, int u, int v) {
+  // Initial Position
+  const int u0 = u & ~0xFFFF;
+  const int v0 = v & ~0xFFFF;
+  // Convolution Area Size
+  const int size = 1 << (s + 1);
+  const double radius = 65536.0 * (1 << s);
+
+  ref_convolve_t c;
+  // Locate Convolution Region
+  ref_blur_locate(&r, &c, u0, v0, size);
+
+  double sum[4] = {0}, count = 0.0;
+  for (int j = c.y1; j < c.y2; j++) {
+    double w_row = 1.0 - fabs(v - v0 - (j << 16)) / radius;
+
+    for (int i = c.x1; i < c.x2; i++) {
+      double w = 1.0 - fabs(u - u0 - (i << 16)) / radius;
+      // Calculate Y * X Weight
+      w = (w > 0.0 && w_row > 0.0) ? w * w_row : 0.0;
+
+      if (w > 0.0 && *r.mask) {
+        // Count Current Pixel
+        for (int k = 0; k < 4; k++)
+          sum[k] += w * (unsigned short) r.buffer[k];
+        count += w;
+      }
+
+      // Step Pixel
+      r.mask++;
+      r.buffer += 4;
+    }
+
+    // Step Stride
+    r.mask += r.s_mask;
+    r.buffer += r.s_buffer;
+  }
+
+  // Calculate Exact Average as Fix15
+  if (count == 0.0)
+    return _mm_set1_epi32(-1);
+  return _mm_setr_epi32(
+    lrint(sum[0] * 0.5 / count), lrint(sum[1] * 0.5 / count),
+    lrint(sum[2] * 0.5 / count), lrint(sum[3] * 0.5 / count));
+}
+
+static void ref_blur_first(brush_render_t* render) {
+  // Check Region Size
+  if (render->w <= 0 || render->h <= 0)
+    return; // Nothing to Do
+
+  int x1, x2, y1, y2;
+  // Blur Opaque Pointer
+  brush_blur_t* blur;
+  ref_region_t region;
+  // Load Blur Opaque Pointer
+  blur = (brush_blur_t*) render->opaque;
+  // Locate Buffer Offset
+  x1 = render->x - blur->x;
+  y1 = render->y - blur->y;
+
+  int stride = render->canvas->stride;
+  // Brush Shape Mask Stride
+  region.s_mask = stride;
+  region.s_buffer = stride << 2;
+  // Define Region Dimensions
+  region.w = blur->w;
+  region.h = blur->h;
+
+  // Load Pixel Buffer Pointer
+  region.mask = render->canvas->buffer0;
+  region.buffer = render->canvas->dst;
+
+  stride = (y1 * stride + x1);
+  // Locate Destination Pointer
+  region.mask += stride;
+  region.buffer += stride << 2;
+
+  const int fx = blur->down_fx;
+  const int fy = blur->down_fy;
+  // Locate Region Position
+  x1 = blur->x;
+  y1 = blur->y;
+  x2 = x1 + render->w;
+  y2 = y1 + render->h;
+  // Locate Position to Auxiliar Buffer
+  x1 = (x1 * blur->sw) / region.w;
+  y1 = (y1 * blur->sh) / region.h;
+  x2 = (x2 * blur->sw) / region.w;
+  y2 = (y2 * blur->sh) / region.h;
+
+  int level, yy, xx, oo;
+  // Load Current Level
+  level = render->alpha;
+  // Load Current Offset
+  oo = blur->offset;
+  // Locate Fixlinear Positions
+  yy = y1 * fy + oo;
+  xx = x1 * fx + oo;
+
+  __m128i xmm0; short *aux_y, *aux_x;
+  // Load Auxiliar Buffer Pointer
+  aux_y = render->canvas->buffer1;
+  // Change Stride to Auxiliar
+  stride = blur->sw;
+  // Locate Auxuliar Buffer Pointer
+  aux_y += (y1 * stride + x1) << 2;
+  // Change Stride to Auxiliar Pixels
+  stride <<= 2;
+
+  for (int y = y1; y < y2; y++) {
+    aux_x = aux_y;
+    oo = xx;
+
+    for (int x = x1; x < x2; x++) {
+      // Calculate Average of Current Downscaled Pixel
+      xmm0 = (ref_exact) ?
+        ref_blur_exact(region, level, oo, yy) :
+        ref_blur_linear(region, level, oo, yy);
+      // Pack Pixel and Store
+      xmm0 = _mm_packs_epi32(xmm0, xmm0);
+      _mm_storel_epi64((__m128i*) aux_x, xmm0);
+
+      aux_x += 4;
+      // Step X Fixlinear
+      oo += fx;
+    }
+
+    aux_y += stride;
+    // Step Y Fixlinear
+    yy += fy;
+  }
+}
+
+// ---------------------------
+// TENT BLUR BENCHMARK HELPERS
+// ---------------------------
+
+typedef void (*bench_proc_t)(brush_render_t* render);
+
+static double bench_now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+static void bench_fill(short* buffer, int count, int seed) {
+  srand(seed);
+  for (int i = 0; i < count; i++)
+    buffer[i] = (short) (rand() & 0xFFFF);
+}
+
+static double bench_run(bench_proc_t proc, brush_render_t* render, int rounds) {
+  double t0 = bench_now();
+  for (int i = 0; i < rounds; i++)
+    proc(render);
+  // Milliseconds per Round
+  return (bench_now() - t0) / rounds;
+}
+
+static int bench_diff(short* a, short* b, int count) {
+  int diff = 0;
+  for (int i = 0; i < count; i++) {
+    int d = a[i] - b[i];
+    if (d < 0) d = -d;
+    if (d > diff) diff = d;
+  }
+
+  return diff;
+}
+
+static int bench_fix(int size, int scale) {
+  return (int) ((double) scale / size * 65536.0);
+}
+
+// --------------------------
+// TENT BLUR BENCHMARK RUNNER
+// --------------------------
+
+int main(int argc, char** argv) {
+  const int size = (argc > 1) ? atoi(argv[1]) : 256;
+  const int rounds = (argc > 2) ? atoi(argv[2]) : 20;
+  const int count = size * size;
+  // Allocate Canvas Buffers
+  short* dst = malloc(count * 4 * sizeof(short));
+  short* mask = malloc(count * sizeof(short));
+  short* aux0 = calloc(count * 4, sizeof(short));
+  short* aux1 = calloc(count * 4, sizeof(short));
+  short* aux2 = calloc(count * 4, sizeof(short));
+  bench_fill(dst, count * 4, 1);
+  bench_fill(mask, count, 2);
+  for (int i = 0; i < count; i++)
+    if (i % 5 == 0) mask[i] = 0;
+
+  brush_canvas_t canvas = {0};
+  canvas.w = size;
+  canvas.h = size;
+  canvas.stride = size;
+  canvas.dst = dst;
+  canvas.buffer0 = mask;
+
+  brush_render_t render = {0};
+  render.w = size;
+  render.h = size;
+  render.canvas = &canvas;
+
+  int worst = 0;
+  // Compare Each Blur Level
+  const float scales[] = {1.5, 3.0, 6.0, 12.0, 24.0, 48.0};
+  for (int k = 0; k < 6; k++) {
+    const float scale = scales[k];
+    const int sw = (int) (size / scale + 0.999);
+
+    brush_blur_t blur = {0};
+    blur.w = blur.h = size;
+    blur.sw = blur.sh = sw;
+    blur.down_fx = blur.down_fy = bench_fix(sw, size);
+    blur.up_fx = blur.up_fy = bench_fix(size, sw);
+    blur.offset = (int) (scale * 32768.0);
+    render.opaque = &blur;
+    render.alpha = (int) log2f(scale);
+
+    double t0, t1;
+    // Baseline Linear Convolution
+    canvas.buffer1 = aux0;
+    t0 = bench_run(ref_blur_first, &render, rounds);
+    // Separable Tent
+    blur.scratch = malloc(brush_blur_scratch(&render) * sizeof(float));
+    canvas.buffer1 = aux1;
+    t1 = bench_run(brush_blur_first, &render, rounds);
+    free(blur.scratch);
+
+    // Exact Float Tent
+    ref_exact = 1;
+    canvas.buffer1 = aux2;
+    ref_blur_first(&render);
+    ref_exact = 0;
+
+    int base = bench_diff(aux0, aux1, sw * sw * 4);
+    int diff = bench_diff(aux2, aux1, sw * sw * 4);
+    int quant = bench_diff(aux2, aux0, sw * sw * 4);
+    if (diff > worst) worst = diff;
+    printf("blur %dx%d level %d: baseline %.3f ms, separable %.3f ms, %.2fx\n",
+      size, size, render.alpha, t0, t1, t0 / t1);
+    printf("  max diff: separable-baseline %d, separable-exact %d, baseline-exact %d\n",
+      base, diff, quant);
+  }
+
+  // Dealloc Canvas Buffers
+  free(dst);
+  free(mask);
+  free(aux0);
+  free(aux1);
+  free(aux2);
+  // Tolerance: 1 LSB of Fix15 from Exact Tent
+  return worst > 1;
+}
@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+#include "../brush.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ------------------------------
+// PER-PIXEL RESAMPLING REFERENCE
+// ------------------------------
+
+static __m128i _mm_mix_65535(__m128i xmm0, __m128i xmm1, __m128i fract) {
+  const __m128i one = _mm_set1_epi32(65535);
+  // Calculate Interpolation
+  xmm1 = _mm_mullo_epi32(xmm1, fract);
+  fract = _mm_sub_epi32(one, fract);
+  xmm0 = _mm_mullo_epi32(xmm0, fract);
+  xmm0 = _mm_add_epi32(xmm0, xmm1);
+  // Ajust 16bit Fixed Point
+  xmm0 = _mm_add_epi32(xmm0, one);
+  xmm0 = _mm_srli_epi32(xmm0, 16);
+  // Return Interpolated
+  return xmm0;
+}
+
+static __m128i ref_smudge_sample(short* src, int w, int h, int x, int y) {
+  if (x < 0) x = 0; else if (x >= w) x = w - 1;
+  if (y < 0) y = 0; else if (y >= h) y = h - 1;
+
+  __m128i pixel;
+  // Locate Pixel and Unpack
+  src += (y * w + x) << 2;
+  pixel = _mm_loadl_epi64((__m128i*) src);
+  pixel = _mm_cvtepu16_epi32(pixel);
+
+  // Return Pixel
+  return pixel;
+}
+
+static __m128i ref_smudge_bilinear(short* src, int w, int h, int u, int v) {
+  const int x = u >> 16;
+  const int y = v >> 16;
+
+  __m128i m00, m10, m01, m11, fx, fy;
+  // Position Fractional Part
+  fx = _mm_set1_epi32(u & 0xFFFF);
+  fy = _mm_set1_epi32(v & 0xFFFF);
+  // Sample Four Clammped Pixels
+  m00 = ref_smudge_sample(src, w, h, x + 0, y + 0);
+  m10 = ref_smudge_sample(src, w, h, x + 1, y + 0);
+  m01 = ref_smudge_sample(src, w, h, x + 0, y + 1);
+  m11 = ref_smudge_sample(src, w, h, x + 1, y + 1);
+
+  // Interpolate Bilinear
+  m00 = _mm_mix_65535(m00, m10, fx);
+  m11 = _mm_mix_65535(m01, m11, fx);
+  return _mm_mix_65535(m00, m11, fy);
+}
+
+static void ref_smudge_first(brush_render_t* render) {
+  const int w = render->canvas->w;
+  const int h = render->canvas->h;
+  const brush_smudge_t* s = (brush_smudge_t*) render->opaque;
+  // Load Position Delta
+  int dy = (render->y << 16) - s->dy;
+  int stride = render->canvas->stride << 2;
+  short* dst = render->canvas->buffer1;
+  dst += (render->y * render->canvas->stride + render->x) << 2;
+
+  for (int y = 0; y < render->h; y++) {
+    int dx = (render->x << 16) - s->dx;
+    short* dst0 = dst;
+
+    for (int x = 0; x < render->w; x++) {
+      __m128i xmm0 = ref_smudge_bilinear(
+        render->canvas->dst, w, h, dx, dy);
+      xmm0 = _mm_packus_epi32(xmm0, xmm0);
+      _mm_storel_epi64((__m128i*) dst0, xmm0);
+      // Step Pixel
+      dst0 += 4;
+      dx += 65536;
+    }
+
+    // Step Stride
+    dst += stride;
+    dy += 65536;
+  }
+}
+
+static __m128i ref_water_pixel(short* buffer, int stride, int u, int v) {
+  int x = u >> 16;
+  int y = v >> 16;
+  // Buffer Position
+  x = (y * stride + x) << 2;
+  y = x + (stride << 2);
+
+  __m128i fx, fy, xmm0, m00, m10, m01, m11;
+  fx = _mm_set1_epi32(u & 0xFFFF);
+  fy = _mm_set1_epi32(v & 0xFFFF);
+  // Load Four Pixels
+  xmm0 = _mm_loadu_si128((__m128i*) (buffer + x));
+  m00 = _mm_cvtepu16_epi32(xmm0);
+  m10 = _mm_cvtepu16_epi32(_mm_srli_si128(xmm0, 8));
+  xmm0 = _mm_loadu_si128((__m128i*) (buffer + y));
+  m01 = _mm_cvtepu16_epi32(xmm0);
+  m11 = _mm_cvtepu16_epi32(_mm_srli_si128(xmm0, 8));
+
+  // Interpolate Bilinear
+  m00 = _mm_mix_65535(m00, m10, fx);
+  m11 = _mm_mix_65535(m01, m11, fx);
+  return _mm_mix_65535(m00, m11, fy);
+}
+
+static void ref_water_blend(brush_render_t* render) {
+  const __m128i one = _mm_set1_epi32(65535);
+  brush_water_t* water = (brush_water_t*) render->opaque;
+  const int s_shape = render->canvas->stride;
+  // Locate Buffers
+  short* dst = render->canvas->dst;
+  unsigned short* sh = (unsigned short*) render->canvas->buffer0;
+  dst += (render->y * s_shape + render->x) << 2;
+  sh += render->y * s_shape + render->x;
+  int yy = water->y;
+
+  for (int y = 0; y < render->h; y++) {
+    int xx = water->x;
+
+    for (int x = 0; x < render->w; x++) {
+      int a = sh[x];
+      if (a) {
+        __m128i color, alpha, xmm0, xmm1;
+        alpha = _mm_set1_epi32(a);
+        color = ref_water_pixel(render->canvas->buffer1,
+          water->stride, xx, yy);
+        // Interpolate To Color
+        xmm0 = _mm_loadl_epi64((__m128i*) (dst + (x << 2)));
+        xmm0 = _mm_cvtepu16_epi32(xmm0);
+        xmm1 = _mm_sub_epi32(one, alpha);
+        xmm0 = _mm_mullo_epi32(xmm0, xmm1);
+        xmm1 = _mm_mullo_epi32(color, alpha);
+        xmm0 = _mm_add_epi32(xmm0, xmm1);
+        xmm0 = _mm_add_epi32(xmm0, one);
+        xmm0 = _mm_srli_epi32(xmm0, 16);
+        xmm0 = _mm_packus_epi32(xmm0, xmm0);
+        _mm_storel_epi64((__m128i*) (dst + (x << 2)), xmm0);
+      }
+      // Step X Fixlinear
+      xx += water->fx;
+    }
+
+    // Step Stride
+    sh += s_shape;
+    dst += s_shape << 2;
+    yy += water->fy;
+  }
+}
+
+// ---------------------------
+// RESAMPLING BENCHMARK HELPERS
+// ---------------------------
+
+typedef void (*bench_proc_t)(brush_render_t* render);
+
+static double bench_now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+static void bench_fill(short* buffer, int count, int seed) {
+  srand(seed);
+  for (int i = 0; i < count; i++)
+    buffer[i] = (short) (rand() & 0xFFFF);
+}
+
+static double bench_run(bench_proc_t proc, brush_render_t* render, int rounds) {
+  double t0 = bench_now();
+  for (int i = 0; i < rounds; i++)
+    proc(render);
+  // Milliseconds per Round
+  return (bench_now() - t0) / rounds;
+}
+
+static int bench_diff(short* a, short* b, int count) {
+  int diff = 0;
+  for (int i = 0; i < count; i++) {
+    int d = (unsigned short) a[i] - (unsigned short) b[i];
+    if (d < 0) d = -d;
+    if (d > diff) diff = d;
+  }
+
+  return diff;
+}
+
+// ---------------------------
+// RESAMPLING BENCHMARK RUNNER
+// ---------------------------
+
+int main(int argc, char** argv) {
+  const int size = (argc > 1) ? atoi(argv[1]) : 256;
+  const int rounds = (argc > 2) ? atoi(argv[2]) : 200;
+  const int count = size * size * 4;
+  // Allocate Canvas Buffers
+  short* dst = calloc(count, sizeof(short));
+  short* src = calloc(count, sizeof(short));
+  short* buffer0 = calloc(count, sizeof(short));
+  short* buffer1 = calloc(count, sizeof(short));
+  short* result = calloc(count, sizeof(short));
+  bench_fill(src, count, 1);
+
+  brush_canvas_t canvas = {0};
+  canvas.w = size;
+  canvas.h = size;
+  canvas.stride = size;
+  canvas.dst = src;
+  canvas.buffer0 = buffer0;
+  canvas.buffer1 = buffer1;
+
+  brush_render_t render = {0};
+  render.w = size;
+  render.h = size;
+  render.canvas = &canvas;
+
+  // Smudge Subpixel Delta
+  brush_smudge_t smudge = {0};
+  smudge.dx = 0x1A3C0;
+  smudge.dy = -0x0B7F0;
+  render.opaque = &smudge;
+
+  double t0, t1;
+  t0 = bench_run(ref_smudge_first, &render, rounds);
+  memcpy(result, buffer1, count * sizeof(short));
+  t1 = bench_run(brush_smudge_first, &render, rounds);
+  printf("smudge %dx%d: per-pixel %.3f ms, batched %.3f ms, %.2fx, max diff %d\n",
+    size, size, t0, t1, t0 / t1, bench_diff(result, buffer1, count));
+
+  // Watercolor Upscaled Buffer
+  brush_water_t water = {0};
+  water.stride = size;
+  water.fx = (15 << 16) / size;
+  water.fy = (15 << 16) / size;
+  bench_fill(buffer1, count, 2);
+  bench_fill(buffer0, size * size, 3);
+  for (int i = 0; i < size * size; i++)
+    if (i % 7 == 0) buffer0[i] = 0;
+  canvas.dst = dst;
+  render.w = size - 2;
+  render.h = size - 2;
+  render.opaque = &water;
+
+  bench_fill(dst, count, 4);
+  t0 = bench_run(ref_water_blend, &render, rounds);
+  memcpy(result, dst, count * sizeof(short));
+  bench_fill(dst, count, 4);
+  t1 = bench_run(brush_water_blend, &render, rounds);
+  printf("water %dx%d: per-pixel %.3f ms, batched %.3f ms, %.2fx, max diff %d\n",
+    size, size, t0, t1, t0 / t1, bench_diff(result, dst, count));
+
+  // Dealloc Canvas Buffers
+  free(dst);
+  free(src);
+  free(buffer0);
+  free(buffer1);
+  free(result);
+  return 0;
+}
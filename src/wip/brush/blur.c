@@ -109,82 +109,6 @@ static void brush_blur_locate(blur_region_t* r, blur_convolve_t* c, int u0, int
 // BRUSH BLUR SCALING CONVOLUTION
 // ------------------------------
 
-static __m128i brush_blur_linear(blur_region_t r, const int s, int u, int v) {
-  // Initial Position
-  const int u0 = u & ~0xFFFF;
-  const int v0 = v & ~0xFFFF;
-
-  // Convolution Area Size
-  const int size = 1 << (s + 1);
-  const int scaler = 24 - s;
-
-  blur_convolve_t c;
-  // Locate Convolution Region
-  brush_blur_locate(&r, &c, u0, v0, size);
-
-  __m128i xmm0, xmm1, xmm2;
-  // Initialize Pixel Accumulator
-  xmm0 = _mm_setzero_si128();
-  int count = 0, vj, ui;
-  unsigned int w, w_row;
-
-  for (int j = c.y1; j < c.y2; j++) {
-    vj = v - v0 - (j << 16);
-    w_row = _mm_linear_65535(s, vj);
-
-    for (int i = c.x1; i < c.x2; i++) {
-      ui = u - u0 - (i << 16);
-      w = _mm_linear_65535(s, ui);
-      // Calculate Y * X Weight
-      w = (w_row * w) >> scaler;
-
-      if (w > 0 && *r.mask) {
-        // Load Current Weight Pixel
-        xmm1 = _mm_loadl_epi64((__m128i*) r.buffer);
-        xmm1 = _mm_cvtepu16_epi32(xmm1);
-        // Load Four Weights
-        xmm2 = _mm_cvtsi32_si128(w);
-        xmm2 = _mm_shuffle_epi32(xmm2, 0);
-
-        // Count Current Pixel
-        xmm1 = _mm_mullo_epi32(xmm1, xmm2);
-        xmm0 = _mm_add_epi32(xmm0, xmm1);
-        // Count Current Weight
-        count += w;
-      }
-
-      // Step Pixel
-      r.mask++;
-      r.buffer += 4;
-    }
-
-    // Step Stride
-    r.mask += r.s_mask;
-    r.buffer += r.s_buffer;
-  }
-
-  if (count > 0) {
-    __m128 rcp, avg;
-    // Load Four Counts
-    xmm1 = _mm_cvtsi32_si128(count);
-    xmm1 = _mm_shuffle_epi32(xmm1, 0);
-    // Convert to Float
-    avg = _mm_cvtepi32_ps(xmm0);
-    rcp = _mm_cvtepi32_ps(xmm1);
-    // Apply Division
-    rcp = _mm_rcp_ps(rcp);
-    avg = _mm_mul_ps(avg, rcp);
-
-    // Convert Back to Integer
-    xmm0 = _mm_cvtps_epi32(avg);
-    xmm0 = _mm_srli_epi32(xmm0, 1);
-  } else if (count == 0) {
-    xmm0 = _mm_cmpeq_epi32(xmm0, xmm0);
-  }
-
-  return xmm0;
-}
-
 static __m128i brush_blur_quadric(blur_region_t r, int u, int v) {
   // Initial Position
   const int u0 = u & ~0xFFFF;
@@ -258,92 +182,238 @@ static __m128i brush_blur_quadric(blur_region_t r, int u, int v) {
 }
 
 // -----------------------------
-// BRUSH BLUR DOWNSCALE CONVOLVE
+// BRUSH BLUR SEPARABLE CONVOLVE
 // -----------------------------
 
-void brush_blur_first(brush_render_t* render) {
-  // Check Region Size
-  if (render->w <= 0 || render->h <= 0)
-    return; // Nothing to Do
+typedef struct {
+  // Tent Window
+  int i1, i2;
+  // Tent Weights
+  float* weights;
+} blur_tent_t;
 
-  int x1, x2, y1, y2;
-  // Blur Opaque Pointer
+typedef struct {
+  // Downscaled Area
+  int x1, y1, x2, y2;
+  // Fixlinear Positions
+  int xx, yy, fx, fy;
+  // Source Rows Area
+  int r1, r2, size;
+} blur_area_t;
+
+static void brush_blur_tent(blur_tent_t* t, const int s, int u, int w) {
+  // Convolution Area Size
+  const int size = 1 << (s + 1);
+  const int o0 = (size >> 1) - 1;
+  // Initial Position
+  const int u0 = u & ~0xFFFF;
+  const int p = u0 >> 16;
+
+  int i1, i2;
+  // Convolution Window
+  i1 = p - o0;
+  i2 = i1 + size;
+  // Clamp Convolution Window
+  i1 = CLAMP(i1, 0, w);
+  i2 = CLAMP(i2, 0, w);
+  t->i1 = i1;
+  t->i2 = i2;
+
+  // Calculate Linear Weights
+  for (int i = i1; i < i2; i++) {
+    const int ui = u - u0 - ((i - p) << 16);
+    t->weights[i - i1] = (float) _mm_linear_65535(s, ui);
+  }
+}
+
+static void brush_blur_area(brush_render_t* render, blur_area_t* a) {
   brush_blur_t* blur;
-  blur_region_t region;
   // Load Blur Opaque Pointer
   blur = (brush_blur_t*) render->opaque;
-  // Locate Buffer Offset
-  x1 = render->x - blur->x;
-  y1 = render->y - blur->y;
-
-  int stride = render->canvas->stride;
-  // Brush Shape Mask Stride
-  region.s_mask = stride;
-  region.s_buffer = stride << 2;
-  // Define Region Dimensions
-  region.w = blur->w;
-  region.h = blur->h;
-
-  // Load Pixel Buffer Pointer
-  region.mask = render->canvas->buffer0;
-  region.buffer = render->canvas->dst;
-
-  stride = (y1 * stride + x1);
-  // Locate Destination Pointer
-  region.mask += stride;
-  region.buffer += stride << 2;
 
-  const int fx = blur->down_fx;
-  const int fy = blur->down_fy;
+  int x1, x2, y1, y2;
   // Locate Region Position
   x1 = blur->x;
   y1 = blur->y;
   x2 = x1 + render->w;
   y2 = y1 + render->h;
   // Locate Position to Auxiliar Buffer
-  x1 = (x1 * blur->sw) / region.w;
-  y1 = (y1 * blur->sh) / region.h;
-  x2 = (x2 * blur->sw) / region.w;
-  y2 = (y2 * blur->sh) / region.h;
+  a->x1 = (x1 * blur->sw) / blur->w;
+  a->y1 = (y1 * blur->sh) / blur->h;
+  a->x2 = (x2 * blur->sw) / blur->w;
+  a->y2 = (y2 * blur->sh) / blur->h;
 
-  int level, yy, xx, oo;
-  // Load Current Level
-  level = render->alpha;
+  int oo;
   // Load Current Offset
   oo = blur->offset;
+  a->fx = blur->down_fx;
+  a->fy = blur->down_fy;
   // Locate Fixlinear Positions
-  yy = y1 * fy + oo;
-  xx = x1 * fx + oo;
+  a->yy = a->y1 * a->fy + oo;
+  a->xx = a->x1 * a->fx + oo;
 
-  __m128i xmm0; short *aux_y, *aux_x; 
+  int size, o0, v;
+  // Convolution Area Size
+  size = 1 << (render->alpha + 1);
+  o0 = (size >> 1) - 1;
+  a->size = size;
+  // Locate Source Rows
+  v = a->yy >> 16;
+  a->r1 = CLAMP(v - o0, 0, blur->h);
+  v = (a->yy + (a->y2 - a->y1 - 1) * a->fy) >> 16;
+  a->r2 = CLAMP(v - o0 + size, 0, blur->h);
+}
+
+int brush_blur_scratch(brush_render_t* render) {
+  blur_area_t a;
+  // Calculate Downscaled Area
+  brush_blur_area(render, &a);
+  const int cols = a.x2 - a.x1;
+  const int rows = a.r2 - a.r1;
+  // Check Region Size
+  if (cols <= 0 || rows <= 0)
+    return 0;
+
+  // Sums + Tents + Counts + Weights + Align
+  return rows * cols * 5 + cols * 4 + (cols + 1) * a.size + 4;
+}
+
+void brush_blur_first(brush_render_t* render) {
+  // Check Region Size
+  if (render->w <= 0 || render->h <= 0)
+    return; // Nothing to Do
+
+  brush_blur_t* blur;
+  blur_area_t a;
+  // Load Blur Opaque Pointer
+  blur = (brush_blur_t*) render->opaque;
+  brush_blur_area(render, &a);
+
+  int cols, rows, size, level;
+  // Downscaled Columns and Source Rows
+  cols = a.x2 - a.x1;
+  rows = a.r2 - a.r1;
+  // Load Current Level
+  size = a.size;
+  level = render->alpha;
+  // Check Downscaled Size
+  if (cols <= 0 || rows <= 0 || a.y2 <= a.y1)
+    return;
+
+  int s_mask, s_buffer, stride;
+  short *mask, *buffer;
+  // Brush Shape Mask Stride
+  s_mask = render->canvas->stride;
+  s_buffer = s_mask << 2;
+  // Locate Region Offset
+  stride = (render->y - blur->y) * s_mask;
+  stride += (render->x - blur->x);
+  // Load Region Pointers
+  mask = render->canvas->buffer0 + stride;
+  buffer = render->canvas->dst + (stride << 2);
+
+  blur_tent_t *tent_x, tent_y;
+  float *scratch, *count;
+  __m128 *sum;
+  // Align Scratch Buffer
+  scratch = blur->scratch;
+  sum = (__m128*) (((unsigned long long) scratch + 15) & ~15ULL);
+  // Split Scratch Buffer
+  tent_x = (blur_tent_t*) (sum + rows * cols);
+  count = (float*) (tent_x + cols);
+  scratch = count + rows * cols;
+  // Vertical Tent Weights
+  tent_y.weights = scratch;
+  scratch += size;
+
+  // Calculate Horizontal Tents
+  for (int x = 0, u = a.xx; x < cols; x++, u += a.fx) {
+    tent_x[x].weights = scratch;
+    brush_blur_tent(&tent_x[x], level, u, blur->w);
+    scratch += size;
+  }
+
+  __m128 xmm0, xmm1, xmm_w;
+  __m128i xmm_p;
+  float w, c;
+  // Horizontal Tent Pass
+  for (int r = 0; r < rows; r++) {
+    short* mask_row = mask + (a.r1 + r) * s_mask;
+    short* buffer_row = buffer + (a.r1 + r) * s_buffer;
+    __m128* sum_row = sum + r * cols;
+    float* count_row = count + r * cols;
+
+    for (int x = 0; x < cols; x++) {
+      blur_tent_t* t = &tent_x[x];
+      // Reset Accumulators
+      xmm0 = _mm_setzero_ps();
+      c = 0.0;
+
+      for (int i = t->i1; i < t->i2; i++) {
+        // Skip Pixels Outside Shape
+        if (mask_row[i] == 0)
+          continue;
+        // Load Current Pixel
+        xmm_p = _mm_loadl_epi64((__m128i*) (buffer_row + (i << 2)));
+        xmm_p = _mm_cvtepu16_epi32(xmm_p);
+        xmm1 = _mm_cvtepi32_ps(xmm_p);
+        // Accumulate Weighted Pixel
+        w = t->weights[i - t->i1];
+        xmm_w = _mm_set1_ps(w);
+        xmm1 = _mm_mul_ps(xmm1, xmm_w);
+        xmm0 = _mm_add_ps(xmm0, xmm1);
+        c += w;
+      }
+
+      // Store Horizontal Sums
+      sum_row[x] = xmm0;
+      count_row[x] = c;
+    }
+  }
+
+  short *aux_y, *aux_x;
   // Load Auxiliar Buffer Pointer
   aux_y = render->canvas->buffer1;
-  // Change Stride to Auxiliar
   stride = blur->sw;
-  // Locate Auxuliar Buffer Pointer
-  aux_y += (y1 * stride + x1) << 2;
-  // Change Stride to Auxiliar Pixels
+  // Locate Auxiliar Buffer Pointer
+  aux_y += (a.y1 * stride + a.x1) << 2;
   stride <<= 2;
 
-  for (int y = y1; y < y2; y++) {
+  __m128i xmm_c;
+  const __m128i ones = _mm_set1_epi32(-1);
+  // Vertical Tent Pass
+  for (int y = a.y1, v = a.yy; y < a.y2; y++, v += a.fy) {
+    brush_blur_tent(&tent_y, level, v, blur->h);
     aux_x = aux_y;
-    oo = xx;
 
-    for (int x = x1; x < x2; x++) {
-      // Calculate Average of Current Downscaled Pixel
-      xmm0 = brush_blur_linear(region, level, oo, yy);
-      // Pack Pixel and Store
-      xmm0 = _mm_packs_epi32(xmm0, xmm0);
-      _mm_storel_epi64((__m128i*) aux_x, xmm0);
+    for (int x = 0; x < cols; x++) {
+      xmm0 = _mm_setzero_ps();
+      c = 0.0;
+      // Accumulate Weighted Rows
+      for (int j = tent_y.i1; j < tent_y.i2; j++) {
+        const int idx = (j - a.r1) * cols + x;
+        w = tent_y.weights[j - tent_y.i1];
+        xmm_w = _mm_set1_ps(w);
+        xmm1 = _mm_mul_ps(sum[idx], xmm_w);
+        xmm0 = _mm_add_ps(xmm0, xmm1);
+        c += w * count[idx];
+      }
+
+      // Calculate Average as Fix15
+      if (c > 0.0) {
+        xmm_w = _mm_set1_ps(0.5 / c);
+        xmm0 = _mm_mul_ps(xmm0, xmm_w);
+        xmm_c = _mm_cvtps_epi32(xmm0);
+      } else xmm_c = ones;
 
+      // Pack Pixel and Store
+      xmm_c = _mm_packs_epi32(xmm_c, xmm_c);
+      _mm_storel_epi64((__m128i*) aux_x, xmm_c);
       aux_x += 4;
-      // Step X Fixlinear
-      oo += fx;
     }
 
+    // Step Stride
     aux_y += stride;
-    // Step Y Fixlinear
-    yy += fy;
   }
 }
 
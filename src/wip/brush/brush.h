@@ -19,11 +19,15 @@ typedef struct {
 // BRUSH SHAPE MASKING
 // -------------------
 
+typedef struct brush_stamp brush_stamp_t;
+
 typedef struct {
   // Position & Size
   float x, y, size;
   // Style Attribute
   float smooth;
+  // Cached Stamp
+  brush_stamp_t* stamp;
 } brush_circle_t;
 
 typedef struct {
@@ -41,9 +45,22 @@ typedef struct {
   int d, e, f;
   // Brush Bitmap Buffer
   brush_texture_t* tex;
+  // Cached Bitmap Stamp
+  brush_stamp_t* stamp;
   // ------------------
 } brush_bitmap_t;
 
+struct brush_stamp {
+  // Stamp Position & Size
+  int x, y, w, h;
+  // Stamp Coverage Buffer
+  unsigned short* buffer;
+  // Stamp Lazy Source
+  brush_circle_t* circle;
+  brush_bitmap_t* bitmap;
+  int* bands;
+};
+
 // --------------------
 // BRUSH SHAPE BLENDING
 // --------------------
@@ -72,6 +89,8 @@ typedef struct {
   int up_fx, up_fy;
   // Buffer Bilinear Offset
   int offset;
+  // Separable Scratch
+  float* scratch;
 } brush_blur_t;
 
 typedef struct {
@@ -130,6 +149,7 @@ void brush_erase_blend(brush_render_t* render);
 void brush_water_first(brush_render_t* render);
 void brush_water_blend(brush_render_t* render);
 // --------------------------------------------
+int brush_blur_scratch(brush_render_t* render);
 void brush_blur_first(brush_render_t* render);
 void brush_blur_blend(brush_render_t* render);
 // --------------------------------------------
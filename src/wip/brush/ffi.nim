@@ -24,11 +24,21 @@ type
     # Texture Buffer
     w, h, fixed: cint
     buffer: pointer
-  # -------------------------------------------------
+  # -----------------------------------------------
+  NBrushStamp {.importc: "brush_stamp_t" } = object
+    x, y, w, h: cint
+    # Stamp Coverage Buffer
+    buffer: ptr cushort
+    # Stamp Lazy Source
+    circle: ptr NBrushCircle
+    bitmap: ptr NBrushBitmap
+    bands: ptr cint
   NBrushCircle {.importc: "brush_circle_t" } = object
     x, y, size: cfloat
     # Hard & Sharp
     smooth: cfloat
+    # Cached Stamp
+    stamp: ptr NBrushStamp
   NBrushBlotmap {.importc: "brush_blotmap_t" } = object
     # Blotmap Circle
     circle: NBrushCircle
@@ -41,6 +51,7 @@ type
     d, e, f: cint
     # Bitmap Texture Pointer
     tex*: ptr NBrushTexture
+    stamp: ptr NBrushStamp
 
 type
   NBrushAverage {.importc: "brush_average_t" } = object
@@ -65,6 +76,8 @@ type
     up_fx, up_fy: cint
     # Buffer Bilinear Offset
     offset: cint
+    # Separable Scratch
+    scratch: ptr cfloat
   NBrushSmudge {.importc: "brush_smudge_t" } = object
     # Copy Position
     dx, dy: cint
@@ -115,6 +128,7 @@ proc brush_erase_blend(render: ptr NBrushRender)
 proc brush_water_first(render: ptr NBrushRender)
 proc brush_water_blend(render: ptr NBrushRender)
 # ---------------------------------------------
+proc brush_blur_scratch(render: ptr NBrushRender): cint
 proc brush_blur_first(render: ptr NBrushRender)
 proc brush_blur_blend(render: ptr NBrushRender)
 # -----------------------------------------------
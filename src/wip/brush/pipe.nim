@@ -3,7 +3,7 @@
 from bitops import fast_log2
 # Import Multithreading
 import nogui/async/pool
-include ffi
+include ffi, stamp
 
 # ------------------------------
 # BRUSH ENGINE ABSTRACTION TYPES
@@ -41,6 +41,7 @@ type
     # Rendering Blend Data
     data: NBrushData
     render: NBrushRender
+    scratch: seq[cfloat]
   # ----------------------
   NBrushPipeline* = object
     # Brush Pipeline Target
@@ -52,6 +53,7 @@ type
     blend*: NBrushBlend
     # Brush Shape Mask
     mask*: NBrushMask
+    stamps*: NBrushStampCache
     # Base Rendering Color
     color0: array[4, cint]
     color1: array[4, cint]
@@ -69,6 +71,11 @@ type
     pool*: NThreadPool
     # Pipeline Status
     parallel*, skip*: bool
+  NBrushSnapshot* = object
+    color0, color1: array[4, cint]
+    color: array[4, cint]
+    # Pipeline Status
+    skip: bool
 
 # -----------------------------------
 # BRUSH PIPELINE COLOR INITIALIZATION
@@ -92,6 +99,35 @@ proc transparent*(pipe: var NBrushPipeline) =
   pipe.color0 = empty
   pipe.color1 = empty
 
+# -----------------------------
+# BRUSH PIPELINE STATE SNAPSHOT
+# -----------------------------
+
+proc snapshot*(pipe: var NBrushPipeline): NBrushSnapshot =
+  result.color0 = pipe.color0
+  result.color1 = pipe.color1
+  result.color = pipe.color
+  # Pipeline Status
+  result.skip = pipe.skip
+
+proc restore*(pipe: var NBrushPipeline, snap: NBrushSnapshot) =
+  pipe.color0 = snap.color0
+  pipe.color1 = snap.color1
+  pipe.color = snap.color
+  # Pipeline Status
+  pipe.skip = snap.skip
+
+# --------------------------
+# BRUSH PIPELINE STAMP CACHE
+# --------------------------
+
+proc stamp*(pipe: var NBrushPipeline, hard, sharp: cfloat) =
+  stamp(pipe.stamps, pipe.mask.circle, hard, sharp)
+
+proc stamp*(pipe: var NBrushPipeline, serial: int, level: cint;
+    x, y, angle, size, aspect: cfloat) =
+  stamp(pipe.stamps, pipe.mask.bitmap, serial, level, x, y, angle, size, aspect)
+
 # -----------------------------------
 # BRUSH PIPELINE TILES INITIALIZATION
 # -----------------------------------
@@ -623,6 +659,10 @@ proc blur*(pipe: var NBrushPipeline, size: cfloat) =
     b.offset = offset
     # Replace Current Level
     render.alpha = level
+    # Reserve Separable Scratch
+    let l = brush_blur_scratch(render)
+    setLen(tile.scratch, l)
+    b.scratch = if l > 0: addr tile.scratch[0] else: nil
   # Override Parallel Check
   pipe.parallel = max(rw, rh) >= 32
 
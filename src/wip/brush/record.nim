@@ -0,0 +1,203 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+# Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+import ../brush, ../texture
+from std/monotimes import
+  MonoTime, getMonoTime, ticks
+
+# --------------------------
+# BRUSH STROKE RECORD FORMAT
+# --------------------------
+
+const
+  recordMagic = 0x5253504E'u32 # NPSR
+  recordVersion = 1'u32
+
+type
+  NStrokeEvent* = object
+    x*, y*, press*, angle*: float32
+    # Milliseconds From Start
+    time*: uint32
+  NStrokeHeader = object
+    magic, version: uint32
+    # Canvas Dimensions
+    w, h: cint
+    # Stroke Color
+    r, g, b: cint
+    glass: bool
+    slots: array[3, int8]
+    # Stroke Payload
+    config, events: uint32
+  NStrokeRecord* = object
+    w*, h*: cint
+    # Stroke Color
+    r*, g*, b*: cint
+    glass*: bool
+    # Stroke Texture Slots
+    slots: array[3, int8]
+    config: seq[byte]
+    # Stroke Input Events
+    events*: seq[NStrokeEvent]
+    # Stroke Record Status
+    start: MonoTime
+    active: bool
+
+# ---------------------------
+# BRUSH STROKE RECORD CONFIG
+# ---------------------------
+
+iterator sections(path: var NBrushStroke): tuple[p: pointer, size: int] =
+  yield (cast[pointer](addr path.shape), sizeof(path.shape))
+  yield (cast[pointer](addr path.blend), sizeof(path.blend))
+  yield (cast[pointer](addr path.basic), sizeof(path.basic))
+  yield (cast[pointer](addr path.mask), sizeof(path.mask))
+  yield (cast[pointer](addr path.texture), sizeof(path.texture))
+  yield (cast[pointer](addr path.data), sizeof(path.data))
+
+proc slot(textures: openArray[ptr NTexture], tex: ptr NTexture): int8 =
+  result = -1
+  for i, t in pairs(textures):
+    if t == tex:
+      return int8(i)
+
+proc lookup(textures: openArray[ptr NTexture], slot: int8): ptr NTexture =
+  if slot >= 0 and slot < len(textures):
+    result = textures[slot]
+
+# -------------------------
+# BRUSH STROKE RECORD INPUT
+# -------------------------
+
+proc color*(rec: var NStrokeRecord, r, g, b: cint, glass: bool) =
+  rec.r = r
+  rec.g = g
+  rec.b = b
+  # Transparent Color
+  rec.glass = glass
+
+proc start*(rec: var NStrokeRecord, path: var NBrushStroke,
+    w, h: cint, textures: openArray[ptr NTexture]) =
+  rec.w = w
+  rec.h = h
+  # Capture Stroke Config
+  setLen(rec.config, 0)
+  setLen(rec.events, 0)
+  for p, size in path.sections():
+    let l = len(rec.config)
+    setLen(rec.config, l + size)
+    copyMem(addr rec.config[l], p, size)
+  # Capture Stroke Textures
+  rec.slots = [-1'i8, -1, -1]
+  case path.shape
+  of bsBlotmap: rec.slots[0] = slot(textures, path.mask.blot.texture)
+  of bsBitmap: rec.slots[1] = slot(textures, path.mask.bitmap.texture)
+  else: discard
+  if path.texture.enabled:
+    rec.slots[2] = slot(textures, path.texture.texture)
+  # Start Stroke Clock
+  rec.start = getMonoTime()
+  rec.active = true
+
+proc event(rec: var NStrokeRecord, e: var NStrokeEvent) =
+  if not rec.active: return
+  let elapsed = ticks(getMonoTime()) - ticks(rec.start)
+  # Store Milliseconds From Start
+  e.time = uint32(elapsed div 1_000_000)
+  rec.events.add(e)
+
+proc point*(rec: var NStrokeRecord; x, y, press, angle: cfloat) =
+  var e = NStrokeEvent(x: x, y: y, press: press, angle: angle)
+  rec.event(e)
+
+proc skip*(rec: var NStrokeRecord) =
+  var e = NStrokeEvent(press: 2.0)
+  rec.event(e)
+
+# --------------------------
+# BRUSH STROKE RECORD REPLAY
+# --------------------------
+
+proc apply*(rec: NStrokeRecord, path: var NBrushStroke,
+    textures: openArray[ptr NTexture]): bool =
+  var bytes: int
+  for _, size in path.sections():
+    bytes += size
+  # Check Stroke Config Layout
+  if bytes != len(rec.config):
+    echo "[WARNING] stroke record config mismatch"
+    return false
+  # Restore Stroke Config
+  var cursor: int
+  for p, size in path.sections():
+    copyMem(p, unsafeAddr rec.config[cursor], size)
+    cursor += size
+  # Restore Stroke Textures
+  case path.shape
+  of bsBlotmap: path.mask.blot.texture = lookup(textures, rec.slots[0])
+  of bsBitmap: path.mask.bitmap.texture = lookup(textures, rec.slots[1])
+  else: discard
+  path.texture.texture = lookup(textures, rec.slots[2])
+  path.texture.enabled = path.texture.enabled and
+    not isNil(path.texture.texture)
+  # Restore Stroke Color
+  path.color(rec.r, rec.g, rec.b, rec.glass)
+  result = true
+
+# ------------------------
+# BRUSH STROKE RECORD FILE
+# ------------------------
+
+proc finish*(rec: var NStrokeRecord, filename: string) =
+  if not rec.active: return
+  rec.active = false
+  # Prepare Stroke Header
+  let header = NStrokeHeader(
+    magic: recordMagic,
+    version: recordVersion,
+    w: rec.w, h: rec.h,
+    r: rec.r, g: rec.g, b: rec.b,
+    glass: rec.glass,
+    slots: rec.slots,
+    config: uint32 len(rec.config),
+    events: uint32 len(rec.events))
+  # Append Stroke to Record File
+  var file: File
+  if not open(file, filename, fmAppend):
+    echo "[WARNING] failed open stroke record: ", filename
+    return
+  discard file.writeBuffer(unsafeAddr header, sizeof(header))
+  if len(rec.config) > 0:
+    discard file.writeBuffer(addr rec.config[0], len(rec.config))
+  if len(rec.events) > 0:
+    let bytes = len(rec.events) * sizeof(NStrokeEvent)
+    discard file.writeBuffer(addr rec.events[0], bytes)
+  close(file)
+
+proc readRecords*(filename: string): seq[NStrokeRecord] =
+  var file: File
+  if not open(file, filename, fmRead):
+    echo "[WARNING] failed open stroke record: ", filename
+    return
+  # Read Each Stroke Record
+  var header: NStrokeHeader
+  while file.readBuffer(addr header, sizeof(header)) == sizeof(header):
+    if header.magic != recordMagic or header.version != recordVersion:
+      echo "[WARNING] invalid stroke record: ", filename
+      break
+    var rec = NStrokeRecord(
+      w: header.w, h: header.h,
+      r: header.r, g: header.g, b: header.b,
+      glass: header.glass,
+      slots: header.slots)
+    # Read Stroke Payload
+    let
+      bytes0 = int(header.config)
+      bytes1 = int(header.events) * sizeof(NStrokeEvent)
+    setLen(rec.config, int header.config)
+    setLen(rec.events, int header.events)
+    if bytes0 > 0 and file.readBuffer(addr rec.config[0], bytes0) != bytes0:
+      break
+    if bytes1 > 0 and file.readBuffer(addr rec.events[0], bytes1) != bytes1:
+      break
+    # Add Stroke Record
+    result.add(rec)
+  close(file)
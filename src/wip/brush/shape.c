@@ -89,11 +89,164 @@ static short brush_bilinear_zero(brush_texture_t* tex, int x, int y) {
   return m00;
 }
 
+// --------------------------
+// BRUSH STAMP LAZY RENDERING
+// --------------------------
+
+static void brush_stamp_band(brush_stamp_t* stamp, int band) {
+  brush_canvas_t canvas = {0};
+  // Configure Stamp Canvas
+  canvas.w = stamp->w;
+  canvas.h = stamp->h;
+  canvas.stride = stamp->w;
+  canvas.buffer0 = (short*) stamp->buffer;
+
+  brush_render_t render = {0};
+  // Configure Stamp Band of 32 Rows
+  render.y = band << 5;
+  render.w = stamp->w;
+  render.h = stamp->h - render.y;
+  render.h = (render.h > 32) ? 32 : render.h;
+  // Stamp Full Opacity
+  render.flow = 65535;
+  render.canvas = &canvas;
+
+  // Render Stamp Source
+  if (stamp->bitmap)
+    brush_bitmap_mask(&render, stamp->bitmap);
+  else brush_circle_mask(&render, stamp->circle);
+}
+
+static void brush_stamp_fill(brush_stamp_t* stamp, int y1, int y2) {
+  int* bands = stamp->bands;
+  // Stamp Bands Touched by Rows
+  y1 = y1 >> 5;
+  y2 = (y2 + 31) >> 5;
+
+  for (int i = y1; i < y2; i++) {
+    int state = __atomic_load_n(bands + i, __ATOMIC_ACQUIRE);
+    if (state == 2)
+      continue;
+
+    // Claim Band or Wait Other Worker
+    state = 0;
+    if (__atomic_compare_exchange_n(bands + i, &state, 1,
+        0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      brush_stamp_band(stamp, i);
+      __atomic_store_n(bands + i, 2, __ATOMIC_RELEASE);
+    } else while (__atomic_load_n(bands + i, __ATOMIC_ACQUIRE) != 2)
+      _mm_pause();
+  }
+}
+
+// ----------------------------
+// BRUSH CIRCLE STAMP RENDERING
+// ----------------------------
+
+static void brush_stamp_mask(brush_render_t* render, brush_stamp_t* stamp) {
+  int w, h, stride, s_stride;
+  // Render Dimensions
+  w = render->w;
+  h = render->h;
+  // Canvas & Stamp Stride
+  stride = render->canvas->stride;
+  s_stride = stamp->w;
+
+  int x1, y1, x2, y2;
+  // Stamp Region Relative to Render
+  x1 = stamp->x - render->x;
+  y1 = stamp->y - render->y;
+  x2 = x1 + stamp->w;
+  y2 = y1 + stamp->h;
+  // Clip Stamp Region to Render
+  x1 = (x1 < 0) ? 0 : ((x1 > w) ? w : x1);
+  y1 = (y1 < 0) ? 0 : ((y1 > h) ? h : y1);
+  x2 = (x2 < 0) ? 0 : ((x2 > w) ? w : x2);
+  y2 = (y2 < 0) ? 0 : ((y2 > h) ? h : y2);
+  // Render Missing Stamp Rows
+  if (stamp->bands && y1 < y2 && x1 < x2)
+    brush_stamp_fill(stamp,
+      render->y + y1 - stamp->y,
+      render->y + y2 - stamp->y);
+
+  short *dst_y, *dst_x;
+  unsigned short *src_y, *src_x;
+  // Load Mask Buffer Pointer
+  dst_y = render->canvas->buffer0;
+  dst_y += (render->y * stride) + render->x;
+  // Locate Stamp Buffer Pointer
+  src_y = stamp->buffer;
+  src_y += (render->y + y1 - stamp->y) * s_stride;
+  src_y += (render->x + x1 - stamp->x);
+
+  unsigned int flow;
+  // Load Shape Opacity
+  flow = render->flow;
+  // SIMD Stamp Pixels
+  __m128i xmm0, xmm1;
+  const __m128i xmm_flow = _mm_set1_epi16(flow);
+  const __m128i xmm_zero = _mm_setzero_si128();
+  const __m128i xmm_ones = _mm_cmpeq_epi16(xmm_zero, xmm_zero);
+
+  for (int y = 0; y < h; y++) {
+    dst_x = dst_y;
+    // Clear Rows Outside Stamp
+    if (y < y1 || y >= y2) {
+      for (int x = 0; x < w; x++)
+        *(dst_x++) = 0;
+      // Step Stride
+      dst_y += stride;
+      continue;
+    }
+
+    src_x = src_y;
+    // Clear Left Pixels
+    for (int x = 0; x < x1; x++)
+      *(dst_x++) = 0;
+
+    int count = x2 - x1;
+    // Apply Flow to Eight Pixels
+    while (count >= 8) {
+      xmm0 = _mm_loadu_si128((__m128i*) src_x);
+      // Stamp * Flow Rounded Up
+      xmm1 = _mm_mulhi_epu16(xmm0, xmm_flow);
+      xmm0 = _mm_mullo_epi16(xmm0, xmm_flow);
+      xmm0 = _mm_cmpeq_epi16(xmm0, xmm_zero);
+      xmm0 = _mm_andnot_si128(xmm0, xmm_ones);
+      xmm0 = _mm_sub_epi16(xmm1, xmm0);
+      _mm_storeu_si128((__m128i*) dst_x, xmm0);
+      // Step Eight Pixels
+      src_x += 8; dst_x += 8;
+      count -= 8;
+    }
+
+    // Apply Flow to Remaining Pixels
+    while (count > 0) {
+      *(dst_x++) = (*(src_x++) * flow + 65535) >> 16;
+      count--;
+    }
+
+    // Clear Right Pixels
+    for (int x = x2; x < w; x++)
+      *(dst_x++) = 0;
+
+    // Step Stride
+    dst_y += stride;
+    src_y += s_stride;
+  }
+}
+
 // ---------------------------
 // BRUSH CIRCLE MASK RENDERING
 // ---------------------------
 
 void brush_circle_mask(brush_render_t* render, brush_circle_t* circle) {
+  // Use Cached Stamp
+  if (circle->stamp) {
+    brush_stamp_mask(render, circle->stamp);
+    return;
+  }
+
   int z, w, h, stride, count;
   // Render Dimensions
   w = render->w;
@@ -328,6 +481,12 @@ void brush_blotmap_mask(brush_render_t* render, brush_blotmap_t* blot) {
 // ---------------------------
 
 void brush_bitmap_mask(brush_render_t* render, brush_bitmap_t* bitmap) {
+  // Use Cached Bitmap Stamp
+  if (bitmap->stamp) {
+    brush_stamp_mask(render, bitmap->stamp);
+    return;
+  }
+
   int x1, x2, y1, y2;
   // Render Region
   x1 = render->x;
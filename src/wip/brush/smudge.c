@@ -20,34 +20,26 @@ static __m128i _mm_mix_65535(__m128i xmm0, __m128i xmm1, __m128i fract) {
 // BILINEAR INTERPOLATION PROCS
 // ----------------------------
 
-static __m128i brush_smudge_sample(short* src, int w, int h, int x, int y) {
+static __m128i brush_smudge_sample(short* row, int w, int x) {
   if (x < 0) x = 0; else if (x >= w) x = w - 1;
-  if (y < 0) y = 0; else if (y >= h) y = h - 1;
 
   __m128i pixel;
   // Locate Pixel and Unpack
-  src += (y * w + x) << 2;
-  pixel = _mm_loadl_epi64((__m128i*) src);
+  row += x << 2;
+  pixel = _mm_loadl_epi64((__m128i*) row);
   pixel = _mm_cvtepu16_epi32(pixel);
 
   // Return Pixel
   return pixel;
 }
 
-static __m128i brush_smudge_bilinear(short* src, int w, int h, int u, int v) {
-  // Pixel Position
-  const int x = u >> 16;
-  const int y = v >> 16;
-
-  __m128i m00, m10, m01, m11, fx, fy;
-  // Position Fractional Part
-  fx = _mm_set1_epi32(u & 0xFFFF);
-  fy = _mm_set1_epi32(v & 0xFFFF);
+static __m128i brush_smudge_bilinear(short* row0, short* row1, int w, int x, __m128i fx, __m128i fy) {
+  __m128i m00, m10, m01, m11;
   // Sample Four Clammped Pixels
-  m00 = brush_smudge_sample(src, w, h, x + 0, y + 0);
-  m10 = brush_smudge_sample(src, w, h, x + 1, y + 0);
-  m01 = brush_smudge_sample(src, w, h, x + 0, y + 1);
-  m11 = brush_smudge_sample(src, w, h, x + 1, y + 1);
+  m00 = brush_smudge_sample(row0, w, x + 0);
+  m10 = brush_smudge_sample(row0, w, x + 1);
+  m01 = brush_smudge_sample(row1, w, x + 0);
+  m11 = brush_smudge_sample(row1, w, x + 1);
 
   // Interpolate Horizontally
   m00 = _mm_mix_65535(m00, m10, fx);
@@ -59,12 +51,75 @@ static __m128i brush_smudge_bilinear(short* src, int w, int h, int u, int v) {
   return m00;
 }
 
+// ------------------------------
+// BILINEAR BATCHED ROW SAMPLING
+// ------------------------------
+
+static void brush_smudge_batch(short* row, __m128i fx, __m128i* out) {
+  __m128i xmm0, xmm1, xmm2, m0, m1, m2, m3, m4;
+  // Load Five Contiguous Pixels
+  xmm0 = _mm_loadu_si128((__m128i*) row);
+  xmm1 = _mm_loadu_si128((__m128i*) (row + 8));
+  xmm2 = _mm_loadl_epi64((__m128i*) (row + 16));
+  // Unpack Five Contiguous Pixels
+  m0 = _mm_cvtepu16_epi32(xmm0);
+  m1 = _mm_cvtepu16_epi32(_mm_srli_si128(xmm0, 8));
+  m2 = _mm_cvtepu16_epi32(xmm1);
+  m3 = _mm_cvtepu16_epi32(_mm_srli_si128(xmm1, 8));
+  m4 = _mm_cvtepu16_epi32(xmm2);
+
+  // Interpolate Four Pixels Horizontally
+  out[0] = _mm_mix_65535(m0, m1, fx);
+  out[1] = _mm_mix_65535(m1, m2, fx);
+  out[2] = _mm_mix_65535(m2, m3, fx);
+  out[3] = _mm_mix_65535(m3, m4, fx);
+}
+
+static void brush_smudge_row(short* dst, short* row0, short* row1, int w, int x, int count, __m128i fx, __m128i fy) {
+  __m128i xmm0, xmm1, top[4], bot[4];
+  // Four Pixels Unclamped Range
+  const int x1 = (x < 0) ? -x : 0;
+  const int x2 = w - 5 - x;
+
+  for (int i = 0; i < count;) {
+    // Sample Four Pixels Without Clamping
+    if (i >= x1 && i <= x2 && i + 4 <= count) {
+      brush_smudge_batch(row0 + ((x + i) << 2), fx, top);
+      brush_smudge_batch(row1 + ((x + i) << 2), fx, bot);
+      // Interpolate Four Pixels Vertically
+      xmm0 = _mm_mix_65535(top[0], bot[0], fy);
+      xmm1 = _mm_mix_65535(top[1], bot[1], fy);
+      xmm0 = _mm_packus_epi32(xmm0, xmm1);
+      _mm_storeu_si128((__m128i*) dst, xmm0);
+      // Interpolate Four Pixels Vertically
+      xmm0 = _mm_mix_65535(top[2], bot[2], fy);
+      xmm1 = _mm_mix_65535(top[3], bot[3], fy);
+      xmm0 = _mm_packus_epi32(xmm0, xmm1);
+      _mm_storeu_si128((__m128i*) (dst + 8), xmm0);
+
+      // Step Four Pixels
+      dst += 16;
+      i += 4;
+      continue;
+    }
+
+    // Sample Bilinear Clammped Pixel
+    xmm0 = brush_smudge_bilinear(row0, row1, w, x + i, fx, fy);
+    xmm0 = _mm_packus_epi32(xmm0, xmm0);
+    // Store Current Pixel
+    _mm_storel_epi64((__m128i*) dst, xmm0);
+
+    // Step Pixel
+    dst += 4;
+    i++;
+  }
+}
+
 // ----------------------------
 // SMUDGE BUFFER BLENDING PROCS
 // ----------------------------
 
 void brush_smudge_first(brush_render_t* render) {
-  __m128i xmm0;
   // Destination Region
   int x1 = render->x;
   int y1 = render->y;
@@ -76,10 +131,15 @@ void brush_smudge_first(brush_render_t* render) {
 
   const brush_smudge_t* s = (brush_smudge_t*) render->opaque;
   // Load Position Delta
-  int dx0, dx = (x1 << 16) - s->dx;
+  int dx = (x1 << 16) - s->dx;
   int dy = (y1 << 16) - s->dy;
 
-  short *src, *dst, *dst0;
+  __m128i fx, fy;
+  // Position Fractional Part
+  fx = _mm_set1_epi32(dx & 0xFFFF);
+  fy = _mm_set1_epi32(dy & 0xFFFF);
+
+  short *src, *dst, *row0, *row1;
   int stride = render->canvas->stride;
   // Canvas Pixel Buffer Stride
   src = render->canvas->dst;
@@ -90,21 +150,18 @@ void brush_smudge_first(brush_render_t* render) {
   stride <<= 2;
 
   for (int y = y1; y < y2; y++) {
-    dst0 = dst;
-    dx0 = dx;
-
-    for (int x = x1; x < x2; x++) {
-      // Sample Bilinear Clammped Pixel
-      xmm0 = brush_smudge_bilinear(src, w, h, dx0, dy);
-      xmm0 = _mm_packus_epi32(xmm0, xmm0);
-      // Store Current Pixel
-      _mm_storel_epi64((__m128i*) dst0, xmm0);
-
-      // Step Pixel
-      dst0 += 4;
-      // Step Src
-      dx0 += 65536;
-    }
+    int v0 = dy >> 16;
+    int v1 = v0 + 1;
+    // Clamp Source Rows
+    if (v0 < 0) v0 = 0; else if (v0 >= h) v0 = h - 1;
+    if (v1 < 0) v1 = 0; else if (v1 >= h) v1 = h - 1;
+    // Locate Source Rows
+    row0 = src + ((v0 * w) << 2);
+    row1 = src + ((v1 * w) << 2);
+
+    // Sample Bilinear Row
+    brush_smudge_row(dst, row0, row1,
+      w, dx >> 16, x2 - x1, fx, fy);
 
     // Step Stride
     dst += stride;
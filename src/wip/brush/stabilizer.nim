@@ -1,11 +1,12 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 # Copyright (c) 2021 Cristian Camilo Ruiz <mrgaturus>
+from math import sqrt
 
 # TODO: Untangle Stroke Objects from brush.nim
 # TODO: use NBrushPoint from brush.nim after untangling
 
 type
-  NBrushStable = object
+  NBrushStable* = object
     x*, y*: cfloat
     press*, angle*: cfloat
   NBrushStabilizer* = object
@@ -15,6 +16,12 @@ type
     count: cint
     # Stabilizer Accumulator
     acc, first: NBrushStable
+  NBrushPredictor* = object
+    # Predictor Options
+    lead*: cfloat
+    count: cint
+    # Predictor Velocity
+    last, delta: NBrushStable
 
 # -----------------------------
 # Brush Stable Point Operations
@@ -85,3 +92,51 @@ proc smooth*(s: var NBrushStabilizer; x, y, press, angle: cfloat): NBrushStable
   # Stabilize Point
   s.accumulate(result)
   result = s.average()
+
+# --------------------------
+# Brush Predictor Operations
+# --------------------------
+
+proc reset*(p: var NBrushPredictor, lead: cfloat) =
+  p.lead = lead
+  # Reset Velocity
+  p.count = 0
+  p.delta = default(NBrushStable)
+
+proc track*(p: var NBrushPredictor; x, y, press: cfloat) =
+  let point = NBrushStable(x: x, y: y, press: press)
+  # Smooth Point Velocity
+  if p.count > 0:
+    var d = point
+    decrement(d, p.last)
+    # Stop Prediction on Held Pen
+    if d.x == 0.0 and d.y == 0.0:
+      p.delta = default(NBrushStable)
+    elif p.count == 1: p.delta = d
+    else: # Exponential Average
+      p.delta.x += (d.x - p.delta.x) * 0.5
+      p.delta.y += (d.y - p.delta.y) * 0.5
+      p.delta.press += (d.press - p.delta.press) * 0.5
+  # Next Point
+  p.last = point
+  inc(p.count)
+
+proc predict*(p: var NBrushPredictor, point: var NBrushStable): bool =
+  result = p.lead > 0.0 and p.count > 1
+  if not result: return
+  let
+    dx = p.delta.x
+    dy = p.delta.y
+    dist = sqrt(dx * dx + dy * dy)
+  # Avoid Predicting Held Pen
+  if dist == 0.0:
+    return false
+  # Clamp Lead Distance
+  var t: cfloat = 1.0
+  if dist > p.lead:
+    t = p.lead / dist
+  # Extrapolate One Step Ahead
+  point = p.last
+  point.x += dx * t
+  point.y += dy * t
+  point.press = clamp(point.press + p.delta.press * t, 0.0, 1.0)
@@ -0,0 +1,287 @@
+# SPDX-License-Identifier: GPL-2.0-or-later
+# Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+from math import sqrt, round, pow
+from std/hashes import Hash, hash, `!&`, `!$`
+import std/tables
+
+# -----------------------
+# BRUSH STAMP CACHE TYPES
+# -----------------------
+
+const
+  # Circle Stamp Quantization
+  stampStyle = 1024.0
+  # Bitmap Stamp Quantization
+  stampAngles = 256.0
+  stampOctave = 32.0
+  stampAspect = 64.0
+  stampTurn = 6.283185307179586
+
+type
+  NBrushStampKey = object
+    # Quantized Size & Phase
+    size, phase: cint
+    # Quantized Hard & Sharp
+    hard, sharp: cint
+    # Bitmap Angle & Aspect
+    angle, aspect: cint
+    # Bitmap Texture Identity
+    serial: int
+    level: cint
+  NBrushStampEntry = object
+    key: NBrushStampKey
+    stamp: NBrushStamp
+    # Stamp Center Padding
+    pad: cint
+    # Stamp Usage
+    bytes: int
+    # Stamp Lazy Source
+    circle: NBrushCircle
+    bitmap: NBrushBitmap
+    tex: NBrushTexture
+    # Stamp Recent Links
+    prev, next: ptr NBrushStampEntry
+  # ------------------------
+  NBrushStampCache* = object
+    slots: Table[NBrushStampKey, ptr NBrushStampEntry]
+    ring: ptr NBrushStampEntry
+    # Cache Memory Budget
+    bytes*, cap*: int
+    # Cache Counters
+    hits*, misses*, evicts*: int
+
+proc `==`(a, b: NBrushStampKey): bool =
+  a.size == b.size and a.phase == b.phase and
+  a.hard == b.hard and a.sharp == b.sharp and
+  a.angle == b.angle and a.aspect == b.aspect and
+  a.serial == b.serial and a.level == b.level
+
+proc hash(key: NBrushStampKey): Hash =
+  result = hash(key.size) !& hash(key.phase)
+  result = result !& hash(key.hard) !& hash(key.sharp)
+  result = result !& hash(key.angle) !& hash(key.aspect)
+  result = !$(result !& hash(key.serial) !& hash(key.level))
+
+# ----------------------
+# BRUSH STAMP CACHE SIZE
+# ----------------------
+
+proc unlink(entry: ptr NBrushStampEntry) =
+  entry.prev.next = entry.next
+  entry.next.prev = entry.prev
+
+proc link(cache: var NBrushStampCache, entry: ptr NBrushStampEntry) =
+  let ring = cache.ring
+  # Link Entry as Most Recent
+  entry.prev = ring
+  entry.next = ring.next
+  ring.next.prev = entry
+  ring.next = entry
+
+proc release(cache: var NBrushStampCache, entry: ptr NBrushStampEntry) =
+  dealloc(entry.stamp.buffer)
+  dealloc(entry.stamp.bands)
+  cache.bytes -= entry.bytes
+  dealloc(entry)
+
+proc evict(cache: var NBrushStampCache): bool =
+  let entry = cache.ring.prev
+  if entry == cache.ring: return false
+  # Release Least Recent Stamp
+  entry.unlink()
+  cache.slots.del(entry.key)
+  cache.release(entry)
+  inc(cache.evicts)
+  result = true
+
+proc clear*(cache: var NBrushStampCache) =
+  for entry in values(cache.slots):
+    cache.release(entry)
+  clear(cache.slots)
+  # Reset Recent Ring
+  if not isNil(cache.ring):
+    cache.ring.prev = cache.ring
+    cache.ring.next = cache.ring
+
+proc configure*(cache: var NBrushStampCache, cap: int) =
+  cache.cap = cap
+  # Create Recent Ring Sentinel
+  if isNil(cache.ring):
+    cache.ring = create(NBrushStampEntry)
+    cache.ring.prev = cache.ring
+    cache.ring.next = cache.ring
+  # Evict Until Fits Budget
+  while cache.bytes > cap:
+    discard cache.evict()
+
+proc ratio*(cache: var NBrushStampCache): float32 =
+  let total = cache.hits + cache.misses
+  # Calculate Hit Ratio
+  if total > 0:
+    result = float32(cache.hits / total)
+
+# ---------------------------
+# BRUSH STAMP CACHE LOCATION
+# ---------------------------
+
+proc phase(x, y: cfloat): tuple[x0, y0: cint, px, py: cint] =
+  var
+    x0 = floor(x)
+    y0 = floor(y)
+    # Quantize Phase to 1/4 Pixel
+    px = cint((x - x0) * 4.0 + 0.5)
+    py = cint((y - y0) * 4.0 + 0.5)
+  # Wrap Phase to Next Pixel
+  if px == 4:
+    x0 += 1.0
+    px = 0
+  if py == 4:
+    y0 += 1.0
+    py = 0
+  # Return Phase
+  result = (cint(x0), cint(y0), px, py)
+
+proc lookup(cache: var NBrushStampCache,
+    key: NBrushStampKey): ptr NBrushStampEntry =
+  result = cache.slots.getOrDefault(key, nil)
+  if isNil(result): return
+  # Touch Stamp Entry
+  result.unlink()
+  cache.link(result)
+  inc(cache.hits)
+
+proc create(cache: var NBrushStampCache, key: NBrushStampKey,
+    side, pad: cint): ptr NBrushStampEntry =
+  let
+    bytes = int(side * side) * sizeof(cushort)
+    # Stamp Bands of 32 Rows
+    count = (side + 31) shr 5
+  # Evict Until Fits Budget
+  while cache.bytes + bytes > cache.cap:
+    if not cache.evict(): break
+  # Allocate Stamp Entry
+  result = create(NBrushStampEntry)
+  result.key = key
+  result.pad = pad
+  result.bytes = bytes
+  cache.slots[key] = result
+  cache.link(result)
+  # Allocate Stamp Buffer, Rendered Lazily by Workers
+  let stamp = addr result.stamp
+  stamp.w = side
+  stamp.h = side
+  stamp.buffer = cast[ptr cushort](alloc(bytes))
+  stamp.bands = cast[ptr cint](alloc0(count * sizeof(cint)))
+  cache.bytes += bytes
+  inc(cache.misses)
+
+proc locate(cache: var NBrushStampCache,
+    entry: ptr NBrushStampEntry, x0, y0: cint): ptr NBrushStamp =
+  entry.stamp.x = x0 - entry.pad
+  entry.stamp.y = y0 - entry.pad
+  # Return Located Stamp
+  result = addr entry.stamp
+
+# ------------------------
+# BRUSH CIRCLE STAMP CACHE
+# ------------------------
+
+proc stamp(cache: var NBrushStampCache, circle: var NBrushCircle,
+    hard, sharp: cfloat) =
+  circle.stamp = nil
+  if cache.cap <= 0:
+    return
+  let
+    # Quantize Size to 1/8 Pixel
+    size = cint(circle.size * 8.0 + 0.5)
+    # Quantize Style to 1/1024 Steps
+    qhard = cint round(hard * stampStyle)
+    qsharp = cint round(sharp * stampStyle)
+    # Stamp Padding & Dimensions
+    pad = (size + 15) shr 4 + 1
+    side = pad * 2 + 2
+  # Avoid Stamps Outside Budget
+  if int(side * side) * sizeof(cushort) > cache.cap:
+    return
+  # Lookup Stamp Entry
+  let p = phase(circle.x, circle.y)
+  let key = NBrushStampKey(
+    size: size, phase: p.px or (p.py shl 2),
+    hard: qhard, sharp: qsharp)
+  var entry = cache.lookup(key)
+  # Prepare New Stamp Circle
+  if isNil(entry):
+    entry = cache.create(key, side, pad)
+    let local = addr entry.circle
+    local.x = cfloat(pad) + cfloat(p.px) * 0.25
+    local.y = cfloat(pad) + cfloat(p.py) * 0.25
+    local.size = cfloat(size) * 0.125
+    style(local[],
+      cfloat(qhard) / stampStyle,
+      cfloat(qsharp) / stampStyle)
+    entry.stamp.circle = local
+  # Locate Stamp to Circle
+  circle.stamp = cache.locate(entry, p.x0, p.y0)
+
+# ------------------------
+# BRUSH BITMAP STAMP CACHE
+# ------------------------
+
+proc angle*(cache: NBrushStampCache, angle: cfloat): cfloat =
+  result = angle
+  # Quantize Angle to Turn Steps
+  if cache.cap > 0:
+    const step = stampTurn / stampAngles
+    result = round(angle / step) * step
+
+proc scale*(cache: NBrushStampCache, size: cfloat): cfloat =
+  result = size
+  # Quantize Size to Octave Steps
+  if cache.cap > 0:
+    result = pow(2.0, round(log2(size) * stampOctave) / stampOctave)
+
+proc aspect*(cache: NBrushStampCache, aspect: cfloat): cfloat =
+  result = aspect
+  # Quantize Aspect Steps
+  if cache.cap > 0:
+    result = round(aspect * stampAspect) / stampAspect
+
+proc stamp(cache: var NBrushStampCache, bitmap: var NBrushBitmap,
+    serial: int, level: cint; x, y, angle, size, aspect: cfloat) =
+  bitmap.stamp = nil
+  if cache.cap <= 0:
+    return
+  let
+    tex = bitmap.tex
+    # Scaled Bitmap Dimensions
+    w = cfloat(tex.w) * bitmap.sx
+    h = cfloat(tex.h) * bitmap.sy
+    # Stamp Padding & Dimensions
+    pad = cint(ceil(sqrt(w * w + h * h) * 0.5)) + 2
+    side = pad * 2 + 2
+  # Avoid Stamps Outside Budget
+  if int(side * side) * sizeof(cushort) > cache.cap:
+    return
+  # Lookup Stamp Entry
+  let p = phase(x, y)
+  let key = NBrushStampKey(
+    size: cint round(log2(size) * stampOctave),
+    phase: p.px or (p.py shl 2),
+    angle: cint(round(angle / stampTurn * stampAngles)) and 0xFF,
+    aspect: cint round(aspect * stampAspect),
+    serial: serial, level: level)
+  var entry = cache.lookup(key)
+  # Prepare New Stamp Bitmap
+  if isNil(entry):
+    entry = cache.create(key, side, pad)
+    let local = addr entry.bitmap
+    entry.tex = tex[]
+    local.tex = addr entry.tex
+    local.sx = bitmap.sx
+    local.sy = bitmap.sy
+    affine(local[],
+      cfloat(pad) + cfloat(p.px) * 0.25,
+      cfloat(pad) + cfloat(p.py) * 0.25, angle)
+    entry.stamp.bitmap = local
+  # Locate Stamp to Bitmap
+  bitmap.stamp = cache.locate(entry, p.x0, p.y0)
@@ -4,10 +4,11 @@
 
 static __m128i _mm_mix_65535(__m128i xmm0, __m128i xmm1, __m128i fract) {
   const __m128i one = _mm_set1_epi32(65535);
-  // Calculate Interpolation
+  // Calculate Interpolation Delta
+  xmm1 = _mm_sub_epi32(xmm1, xmm0);
   xmm1 = _mm_mullo_epi32(xmm1, fract);
-  fract = _mm_sub_epi32(one, fract);
-  xmm0 = _mm_mullo_epi32(xmm0, fract);
+  // Calculate Interpolation as x0 * 65535 + delta
+  xmm0 = _mm_sub_epi32(_mm_slli_epi32(xmm0, 16), xmm0);
   xmm0 = _mm_add_epi32(xmm0, xmm1);
   // Ajust 16bit Fixed Point
   xmm0 = _mm_add_epi32(xmm0, one);
@@ -94,44 +95,96 @@ void brush_water_first(brush_render_t* render) {
 // BRUSH AVERAGED FIXLINEAR BLEND
 // ------------------------------
 
-static __m128i brush_water_pixel(short* buffer, int stride, int u, int v) {
-  int x, y;
-  // Pixel Position
-  x = u >> 16;
-  y = v >> 16;
-  // Buffer Position
-  x = (y * stride + x) << 2;
-  y = x + (stride << 2);
-
-  __m128i fx, fy;
-  // Remainder
-  fx = _mm_set1_epi32(u & 0xFFFF);
-  fy = _mm_set1_epi32(v & 0xFFFF);
-  __m128i xmm0, m00, m10, m01, m11;
-  // Load Top Two Pixels
-  xmm0 = _mm_loadu_si128(
-    (__m128i*) (buffer + x));
-  // Unpack Top Two Pixels
-  m00 = _mm_cvtepu16_epi32(xmm0);
-  xmm0 = _mm_srli_si128(xmm0, 8);
-  m10 = _mm_cvtepu16_epi32(xmm0);
-  // Load Top Two Pixels
-  xmm0 = _mm_loadu_si128(
-    (__m128i*) (buffer + y));
-  // Unpack Top Two Pixels
-  m01 = _mm_cvtepu16_epi32(xmm0);
-  xmm0 = _mm_srli_si128(xmm0, 8);
-  m11 = _mm_cvtepu16_epi32(xmm0);
-
-  __m128i result;
-  // Interpolate Horizontally
-  m00 = _mm_mix_65535(m00, m10, fx);
-  m11 = _mm_mix_65535(m01, m11, fx);
+typedef struct {
+  short *row0, *row1;
+  // Cached Columns
+  __m128i v0, v1, fy;
+  int col;
+} water_row_t;
+
+static __m128i brush_water_column(water_row_t* r, int col) {
+  __m128i m0, m1;
+  // Load Top & Bottom Pixels
+  m0 = _mm_loadl_epi64((__m128i*) (r->row0 + (col << 2)));
+  m1 = _mm_loadl_epi64((__m128i*) (r->row1 + (col << 2)));
+  m0 = _mm_cvtepu16_epi32(m0);
+  m1 = _mm_cvtepu16_epi32(m1);
+
   // Interpolate Vertically
-  result = _mm_mix_65535(m00, m11, fy);
+  return _mm_mix_65535(m0, m1, r->fy);
+}
 
-  // Return Interpolated
-  return result;
+static __m128i brush_water_pixel(water_row_t* r, int u) {
+  const int col = u >> 16;
+  // Reuse Interpolated Columns
+  if (col != r->col) {
+    if (col == r->col + 1)
+      r->v0 = r->v1;
+    else r->v0 = brush_water_column(r, col);
+    // Interpolate Next Column
+    r->v1 = brush_water_column(r, col + 1);
+    r->col = col;
+  }
+
+  __m128i fx;
+  // Interpolate Horizontally
+  fx = _mm_set1_epi32(u & 0xFFFF);
+  return _mm_mix_65535(r->v0, r->v1, fx);
+}
+
+static void brush_water_mix(short* dst, __m128i color, int sh) {
+  __m128i alpha, xmm0;
+  // Load Four Opacity
+  alpha = _mm_cvtsi32_si128(sh);
+  alpha = _mm_shuffle_epi32(alpha, 0);
+  // Load Destination Pixel
+  xmm0 = _mm_loadl_epi64((__m128i*) dst);
+  xmm0 = _mm_cvtepu16_epi32(xmm0);
+
+  // Interpolate To Color
+  xmm0 = _mm_mix_65535(xmm0, color, alpha);
+  // Pack to Fix16 and Store
+  xmm0 = _mm_packus_epi32(xmm0, xmm0);
+  _mm_storel_epi64((__m128i*) dst, xmm0);
+}
+
+static void brush_water_batch(water_row_t* r, short* dst, unsigned short* sh, int u, int fx) {
+  __m128i color, step, alpha;
+  __m128i xmm0, xmm1, xmm2, xmm3;
+  // Interpolate Shared Columns Once
+  brush_water_pixel(r, u);
+  xmm0 = r->v0;
+  xmm1 = _mm_sub_epi32(r->v1, xmm0);
+  // First Pixel as v0 * 65535 + delta * fract
+  color = _mm_sub_epi32(_mm_slli_epi32(xmm0, 16), xmm0);
+  color = _mm_add_epi32(color, _mm_set1_epi32(65535));
+  xmm2 = _mm_set1_epi32(u & 0xFFFF);
+  color = _mm_add_epi32(color, _mm_mullo_epi32(xmm1, xmm2));
+  // Next Pixels Step by delta * fx
+  step = _mm_mullo_epi32(xmm1, _mm_set1_epi32(fx));
+  // Four Pixels Opacity, Zero Keeps Pixel
+  alpha = _mm_loadl_epi64((__m128i*) sh);
+  alpha = _mm_cvtepu16_epi32(alpha);
+
+  for (int i = 0; i < 2; i++) {
+    xmm2 = _mm_loadu_si128((__m128i*) dst);
+    xmm0 = _mm_cvtepu16_epi32(xmm2);
+    xmm1 = _mm_cvtepu16_epi32(_mm_srli_si128(xmm2, 8));
+    // Interpolate Two Pixels Horizontally
+    xmm2 = _mm_srli_epi32(color, 16);
+    color = _mm_add_epi32(color, step);
+    xmm3 = _mm_srli_epi32(color, 16);
+    color = _mm_add_epi32(color, step);
+    // Blend Two Pixels
+    xmm0 = _mm_mix_65535(xmm0, xmm2, _mm_shuffle_epi32(alpha, 0x00));
+    xmm1 = _mm_mix_65535(xmm1, xmm3, _mm_shuffle_epi32(alpha, 0x55));
+    xmm0 = _mm_packus_epi32(xmm0, xmm1);
+    _mm_storeu_si128((__m128i*) dst, xmm0);
+
+    // Step Two Pixels
+    alpha = _mm_srli_si128(alpha, 8);
+    dst += 8;
+  }
 }
 
 void brush_water_blend(brush_render_t* render) {
@@ -158,12 +211,12 @@ void brush_water_blend(brush_render_t* render) {
   // Load Watercolor Pointer
   water = (brush_water_t*) render->opaque;
 
-  short* blur; int stride, size;
+  short* blur; int stride;
   int xx, row_xx, yy, fx, fy;
   // Load Watercolor Buffer
   blur = render->canvas->buffer1;
   // Load Watercolor Stride
-  stride = water->stride;
+  stride = water->stride << 2;
   // Load Watercolor Interpolation
   fx = water->fx; xx = water->x;
   fy = water->fy; yy = water->y;
@@ -174,42 +227,47 @@ void brush_water_blend(brush_render_t* render) {
   // Locate Shape Pointer to Render Position
   sh_y += (render->y * s_shape) + render->x;
 
-  __m128i color, alpha, xmm0, xmm1;
-  // Load Unpacked Color Ones
-  const __m128i one = _mm_set1_epi32(65535);
-
+  water_row_t row; __m128i mask;
   // Apply Blending Mode
   for (int y = y1; y < y2; y++) {
     sh_x = sh_y;
     dst_x = dst_y;
     row_xx = xx;
+    // Locate Watercolor Rows
+    row.row0 = blur + (yy >> 16) * stride;
+    row.row1 = row.row0 + stride;
+    row.fy = _mm_set1_epi32(yy & 0xFFFF);
+    // Invalidate Cached Columns
+    row.col = 0x80000000;
 
-    for (int x = x1; x < x2; x++) {
-      // Check if is not zero
-      if (sh = *sh_x) {
-        alpha = _mm_cvtsi32_si128(sh);
-        alpha = _mm_shuffle_epi32(alpha, 0);
-        // Load Destination Pixel
-        xmm0 = _mm_loadl_epi64((__m128i*) dst_x);
-        xmm0 = _mm_cvtepu16_epi32(xmm0);
-        // Load Color From Blur Buffer
-        color = brush_water_pixel(
-          blur, stride, row_xx, yy);
-
-        // Interpolate To Color
-        xmm1 = _mm_sub_epi32(one, alpha);
-        xmm0 = _mm_mullo_epi32(xmm0, xmm1);
-        xmm1 = _mm_mullo_epi32(color, alpha);
-        xmm0 = _mm_add_epi32(xmm0, xmm1);
-        // Ajust Color Fix16
-        xmm0 = _mm_add_epi32(xmm0, one);
-        xmm0 = _mm_srli_epi32(xmm0, 16);
-
-        // Pack to Fix16 and Store
-        xmm0 = _mm_packus_epi32(xmm0, xmm0);
-        _mm_storel_epi64((__m128i*) dst_x, xmm0);
+    int x = x1;
+    // Blend Four Pixels Batched
+    for (; x + 4 <= x2; x += 4) {
+      mask = _mm_loadl_epi64((__m128i*) sh_x);
+      // Check if are not zero
+      if (_mm_testz_si128(mask, mask) == 0) {
+        // Four Pixels Share Columns
+        if ((row_xx >> 16) == ((row_xx + fx * 3) >> 16))
+          brush_water_batch(&row, dst_x, sh_x, row_xx, fx);
+        else for (int i = 0; i < 4; i++) {
+          if (sh = sh_x[i])
+            brush_water_mix(dst_x + (i << 2),
+              brush_water_pixel(&row, row_xx + fx * i), sh);
+        }
       }
       // Step Shape & Color
+      sh_x += 4; dst_x += 16;
+      // Step X Fixlinear
+      row_xx += fx << 2;
+    }
+
+    // Blend Remaining Pixels
+    for (; x < x2; x++) {
+      // Check if is not zero
+      if (sh = *sh_x)
+        brush_water_mix(dst_x,
+          brush_water_pixel(&row, row_xx), sh);
+      // Step Shape & Color
       sh_x++; dst_x += 4;
       // Step X Fixlinear
       row_xx += fx;
@@ -1,6 +1,7 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 # Copyright (c) 2024 Cristian Camilo Ruiz <mrgaturus>
 import nogui/async/pool
+from std/os import getTempDir
 import image, undo
 import image/[context, composite]
 import canvas/[matrix, render, copy]
@@ -10,6 +11,12 @@ type
     render: NCanvasRenderer
     actives: seq[NCanvasImage]
     pool: NThreadPool
+    # Undo Swap Location
+    swapDir*: string
+    swapBudget*: int64
+    swapDict*: bool
+    # Undo Resident Budget
+    ramBudget*: int64
   NCanvasImage* = ptr object
     man: NCanvasManager
     undo*: NImageUndo
@@ -28,12 +35,18 @@ proc createCanvasManager*(pool: NThreadPool): NCanvasManager =
   result = create(result[].typeof)
   result.render = createCanvasRenderer()
   result.pool = pool
+  # Default Undo Swap Location
+  result.swapDir = getTempDir()
+  result.swapBudget = 2 shl 30
+  result.ramBudget = 256 shl 20
 
 proc createCanvas*(man: NCanvasManager, w, h: cint): NCanvasImage =
   result = create(result[].typeof)
   # Create Canvas Image
   let image = createImage(w, h)
-  let undo = createImageUndo(image)
+  let undo = createImageUndo(image, man.swapDir, man.swapBudget)
+  undo.dictionary(man.swapDict)
+  undo.memory(man.ramBudget)
   result.image = image
   result.undo = undo
   # Create Canvas Viewport
@@ -137,14 +150,6 @@ proc mark(image: NImage, tile: ptr NCanvasTile, level: cint) =
 # Canvas Image Update
 # -------------------
 
-proc composite(image: NImage, pool: NThreadPool) =
-  let com = addr image.com
-  wasMoved(image.test)
-  # Prepare Composite Pipeline
-  com[].stepClear()
-  com[].stepLayer(image.root)
-  com[].dispatch(pool)
-
 proc composite*(canvas: NCanvasImage) =
   let
     image = canvas.image
@@ -157,6 +162,13 @@ proc composite*(canvas: NCanvasImage) =
   let pool = canvas.man.pool
   image.composite(pool)
 
+proc flatten*(canvas: NCanvasImage) =
+  let pool = canvas.man.pool
+  # Dispatch Compositor at Full Level
+  pool.start()
+  canvas.image.flatten(pool)
+  pool.stop()
+
 proc stream*(canvas: NCanvasImage) =
   let
     render = addr canvas.man.render
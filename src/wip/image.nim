@@ -1,6 +1,7 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 # Copyright (c) 2023 Cristian Camilo Ruiz <mrgaturus>
 import nogui/bst
+import nogui/async/pool
 import ./mask/ffi
 import ./image/[
   context,
@@ -449,3 +450,32 @@ proc mergeLayer*(img: NImage, src, dst: NLayer): NLayer =
   dealloc(co.dst.buffer)
   dealloc(co.ext.buffer)
   result.tiles.shrink()
+
+# ---------------
+# Image Composite
+# ---------------
+
+proc composite*(img: NImage, pool: NThreadPool) =
+  let com = addr img.com
+  wasMoved(img.test)
+  # Prepare Composite Pipeline
+  com[].stepClear()
+  com[].stepLayer(img.root)
+  com[].dispatch(pool)
+
+proc flatten*(img: NImage, pool: NThreadPool) =
+  let
+    status = addr img.status
+    com = addr img.com
+    clip0 = status.clip
+    level = com.mipmap
+  # Mark Dirty Tiles at Full Level
+  status.clip.complete()
+  for c in status[].checkFlat(0):
+    com[].mark(c.tx, c.ty)
+    c.check[] = c.check[] or 1
+  status.clip = clip0
+  # Dispatch Compositor at Full Level
+  com.mipmap = 0
+  img.composite(pool)
+  com.mipmap = level
@@ -206,33 +206,36 @@ iterator scan(proxy: ptr NProxyBlock): tuple[tx, ty: cint] =
       # Next Dirty Bit
       dirty = dirty shr 1
 
+proc pull(stream: ptr NProxyStream, co0: NImageCombine; tx, ty: cint): NTileStatus =
+  let
+    tiles = stream.map.tiles
+    tile = tiles[].find(tx, ty)
+  # Prepare Combine Buffers
+  var co = co0.clip32(tx, ty)
+  result = tile.status
+  if result < tsColor:
+    combine_clear(addr co)
+    return
+  # Stream Tile to Proxy
+  co.src = tile.chunk()
+  if result == tsColor:
+    proxy_uniform_fill(addr co)
+    return
+  # Select Proxy Stream
+  case tiles.bits
+  of depth2bpp: proxy_stream2(addr co)
+  of depth4bpp: proxy_stream8(addr co)
+  else: proxy_stream16(addr co)
+
 proc stream(proxy: ptr NProxyBlock) =
   let
     stream = proxy.stream
-    map = stream.map
-    tiles = map.tiles
     # Buffer Combine
-    dst = map.buffer
+    dst = stream.map.buffer
     co0 = combine(dst, dst)
-  # Select Proxy Stream
-  let proxy_stream =
-    case tiles.bits
-    of depth2bpp: proxy_stream2
-    of depth4bpp: proxy_stream8
-    else: proxy_stream16
   # Stream Tiles to Proxy Buffer
   for tx, ty in proxy.scan():
-    let tile = tiles[].find(tx, ty)
-    # Prepare Combine Buffers
-    var co = co0.clip32(tx, ty)
-    if tile.status < tsColor:
-      combine_clear(addr co)
-      continue
-    # Stream Tile to Proxy
-    co.src = tile.chunk()
-    if tile.status == tsColor:
-      proxy_uniform_fill(addr co)
-    else: proxy_stream(addr co)
+    discard stream.pull(co0, tx, ty)
   # Remove Dirty Mark
   wasMoved(proxy.dirty)
 
@@ -282,6 +285,19 @@ proc stream*(proxy: var NImageProxy) =
     if p.dirty > 0:
       stream(addr p)
 
+proc stream*(proxy: var NImageProxy, tx, ty: cint): NTileStatus =
+  let
+    status = proxy.status
+    dst = proxy.stream.map.buffer
+    co0 = combine(dst, dst)
+    idx = ty * (proxy.ctx.w32 shr 5) + tx
+  # Mark Tile as Streamed
+  status.aux[idx] = 2
+  status.flat[idx] = 0
+  status.clip.expand(tx shl 5, ty shl 5, 32, 32)
+  # Stream Single Tile to Proxy
+  result = pull(addr proxy.stream, co0, tx, ty)
+
 # IMPORTANT TODO: multithreading
 proc commit*(proxy: var NImageProxy) =
   proxy.find(check = 2, stage = 0)
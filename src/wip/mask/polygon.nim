@@ -2,6 +2,9 @@
 # Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
 import nogui/async/core
 import ffi, ../image/ffi
+from ../image/tiles import
+  NTileStatus, tsZero, tsColor, tsBuffer
+from std/algorithm import sort
 
 type
   NPolyBounds = object
@@ -12,32 +15,54 @@ type
     x*, y*: float32
   NPolyFix = tuple[x, y: int32]
   NPolySegment = tuple[a, b: NPolyFix]
+  NPolyEdge = object
+    s: NPolySegment
+    # Vertical Range
+    y0, y1: int32
   # -- Polygon Rasterizer: Lane --
   NPolyHits = UncheckedArray[NPolyFix]
-  NPolyGather = UncheckedArray[NPolySegment]
+  NPolyGather = UncheckedArray[NPolyEdge]
   NPolyLane = object
     rast: ptr NPolygon
     offset, skip: int32
     count, cap: int
+    # Lane Active Edges
+    next, cursor: int
+    active: int
     # Lane Temporal Buffers
     bucket: ptr NPolyGather
+    edges: ptr NPolyGather
     hits: ptr NPolyHits
     smooth: pointer
+    band: pointer
   # -- Polygon Rasterizer --
   NPolyRule* = enum
     ruleNonZero
     ruleOddEven
+  NPolyTile* = object
+    status*: NTileStatus
+    buffer*: pointer
   NPolygon* = object
     pool: NThreadPool
-    buffer: NImageBuffer
+    w, h: int32
     # Polygon Points
     bounds: NPolyBounds
     points: seq[NPolyFix]
+    edges: seq[NPolyEdge]
     lanes: seq[NPolyLane]
+    # Polygon Coverage Tiles
+    cells: seq[pointer]
+    tx, ty: int32
+    cols, rows: int32
     # Polygon Properties
     rule*: NPolyRule
     smooth*: bool
 
+# Full Coverage Tile
+proc ones(): array[1024, uint8] =
+  for b in mitems(result): b = 0xFF
+var polyFull {.align: 16.} = ones()
+
 # ---------------------------
 # Polygon Rasterizer Bounding
 # ---------------------------
@@ -74,9 +99,10 @@ proc clip(bounds: var NPolyBounds, w, h: int32): bool =
 # ----------------------------
 
 proc configure*(rast: var NPolygon,
-    pool: NThreadPool, buffer: NImageBuffer) =
+    pool: NThreadPool; w, h: int32) =
   rast.pool = pool
-  rast.buffer = buffer
+  rast.w = w
+  rast.h = h
   # Configure Pool Lanes
   let cores = pool.cores
   setLen(rast.lanes, cores)
@@ -90,6 +116,36 @@ proc clear*(rast: var NPolygon) =
   rast.bounds = newBounds()
   setLen(rast.points, 0)
 
+proc release*(rast: var NPolygon) =
+  let full = addr polyFull
+  # Dealloc Partial Coverage Tiles
+  for cell in items(rast.cells):
+    if not isNil(cell) and cell != full:
+      deallocShared(cell)
+  # Remove Coverage Grid
+  setLen(rast.cells, 0)
+  wasMoved(rast.cols)
+  wasMoved(rast.rows)
+
+proc tile*(rast: var NPolygon, tx, ty: cint): NPolyTile =
+  result.status = tsZero
+  let
+    x = tx - rast.tx
+    y = ty - rast.ty
+  # Check Inside Coverage Grid
+  if x < 0 or y < 0 or x >= rast.cols or y >= rast.rows:
+    return result
+  let cell = rast.cells[y * rast.cols + x]
+  result.buffer = cell
+  # Check Coverage Tile Status
+  if isNil(cell): result.status = tsZero
+  elif cell == addr polyFull: result.status = tsColor
+  else: result.status = tsBuffer
+
+proc full*(rast: var NPolygon): NPolyTile =
+  result.status = tsColor
+  result.buffer = addr polyFull
+
 proc push*(rast: var NPolygon, point: NPolyPoint) =
   var p: NPolyFix = (
     int32(point.x * 256.0 + 0.5) and not 0x7,
@@ -130,50 +186,104 @@ iterator segments(rast: var NPolygon): NPolySegment =
     yield s; inc(i)
   {.pop.}
 
+proc table(rast: var NPolygon) =
+  setLen(rast.edges, 0)
+  # Collect Non Horizontal Edges
+  for s in rast.segments():
+    if s.a.y == s.b.y:
+      continue
+    rast.edges.add NPolyEdge(s: s,
+      y0: min(s.a.y, s.b.y),
+      y1: max(s.a.y, s.b.y))
+  # Sort Edges by Top Position
+  sort(rast.edges, proc(a, b: NPolyEdge): int = cmp(a.y0, b.y0))
+
+proc search(rast: ptr NPolygon, y: int32): int =
+  let edges = addr rast.edges
+  var hi = len(edges[])
+  # Find First Edge Starting After Position
+  while result < hi:
+    let mid = (result + hi) shr 1
+    if edges[][mid].y0 <= y:
+      result = mid + 1
+    else: hi = mid
+
 # -----------------------------------
 # Polygon Rasterizer Scanline: Bucket
 # -----------------------------------
 
-proc inside(s: NPolySegment, y0, y1: int32): bool =
-  let check0 = uint32(s.a.y < y0) or uint32(s.a.y > y1) shl 1
-  let check1 = uint32(s.b.y < y0) or uint32(s.b.y > y1) shl 1
-  (check0 and check1) == 0
-
 proc allocate(lane: ptr NPolyLane) =
   if lane.cap == 0:
-    const bytes = 16384 * sizeof(NPolySegment)
+    const bytes = 16384 * sizeof(NPolyEdge)
     const bytesAux = 16384 * sizeof(NPolyFix)
     # Allocate Lane Buffers with Initial Capacity
     lane.bucket = cast[ptr NPolyGather](alloc bytes)
+    lane.edges = cast[ptr NPolyGather](alloc bytes)
     lane.hits = cast[ptr NPolyHits](alloc bytesAux)
     lane.cap = 16384
     return
   dealloc(lane.hits)
+  dealloc(lane.edges)
   # Expand Bucket Buffer with new Capacity
-  let bytes = lane.cap * sizeof(NPolySegment) * 2
+  let bytes = lane.cap * sizeof(NPolyEdge) * 2
   let bytesAux = lane.cap * sizeof(NPolyFix) * 2
   let buffer = cast[ptr NPolyGather](alloc bytes)
   copyMem(buffer, lane.bucket, bytes shr 1)
   dealloc(lane.bucket)
   lane.bucket = buffer
-  # Expand Polygon Collision Buffer with new Capacity
+  # Expand Active and Collision Buffers with new Capacity
+  lane.edges = cast[ptr NPolyGather](alloc bytes)
   lane.hits = cast[ptr NPolyHits](alloc bytesAux)
   lane.cap *= 2
 
-proc gather(lane: ptr NPolyLane, s: NPolySegment) =
+proc gather(lane: ptr NPolyLane, e: NPolyEdge) =
   if lane.count >= lane.cap:
     lane.allocate()
-  # Add Segment to Bucket
-  lane.bucket[lane.count] = s
+  # Add Edge to Bucket
+  lane.bucket[lane.count] = e
   inc(lane.count)
 
 proc gather(lane: ptr NPolyLane, y0, y1: int32) =
-  let rast = lane.rast
-  lane.count = 0
-  # Collect Segments Inside Range
-  for s in rast[].segments():
-    if s.inside(y0, y1):
-      lane.gather(s)
+  let
+    rast = lane.rast
+    bucket = lane.bucket
+  # Keep Edges Reaching Current Band
+  var count = 0
+  for i in 0 ..< lane.count:
+    if bucket[i].y1 >= y0:
+      bucket[count] = bucket[i]
+      inc(count)
+  lane.count = count
+  # Add Edges Starting Until Band End
+  let last = rast.search(y1)
+  for i in lane.next ..< last:
+    let e = addr rast.edges[i]
+    if e.y1 >= y0:
+      lane.gather(e[])
+  lane.next = last
+  # Reset Scanline Active Edges
+  lane.cursor = 0
+  lane.active = 0
+
+proc advance(lane: ptr NPolyLane, y: int32): int =
+  let
+    bucket = lane.bucket
+    edges = lane.edges
+  # Remove Edges Ended Before Scanline
+  for i in 0 ..< lane.active:
+    if edges[i].y1 >= y:
+      edges[result] = edges[i]
+      inc(result)
+  # Add Edges Started at Scanline
+  while lane.cursor < lane.count:
+    let e = addr bucket[lane.cursor]
+    if e.y0 > y: break
+    if e.y1 >= y:
+      edges[result] = e[]
+      inc(result)
+    inc(lane.cursor)
+  # Store Active Count
+  lane.active = result
 
 # ------------------------------------
 # Polygon Rasterizer Scanline: Sorting
@@ -235,12 +345,12 @@ proc hit(s: NPolySegment, y: int32): NPolyFix =
 proc collide(lane: ptr NPolyLane, y: int32): int =
   result = 0
   # Check Collision Hits
-  let l = lane.count
-  let bucket = lane.bucket
+  let l = lane.advance(y)
+  let edges = lane.edges
   let hits = lane.hits
   # Gather Collision Hits
   for i in 0 ..< l:
-    var hit = bucket[i].hit(y)
+    var hit = edges[i].s.hit(y)
     if hit.y == 0:
       continue
     # Add Collision Hit
@@ -296,14 +406,20 @@ proc nonzero(lane: ptr NPolyLane, y: int32): int =
 proc clear(lane: ptr NPolyLane) =
   if lane.cap > 0:
     dealloc(lane.bucket)
+    dealloc(lane.edges)
     dealloc(lane.hits)
   # Remove Coverage Buffer
   if not isNil(lane.smooth):
     dealloc(lane.smooth)
     wasMoved(lane.smooth)
+  # Remove Band Buffer
+  if not isNil(lane.band):
+    dealloc(lane.band)
+    wasMoved(lane.band)
   # Remove Capacity
   wasMoved(lane.cap)
   wasMoved(lane.count)
+  wasMoved(lane.next)
 
 # -----------------------------------
 # Polygon Rasterizer Scanline: Render
@@ -312,21 +428,54 @@ proc clear(lane: ptr NPolyLane) =
 proc prepare(lane: ptr NPolyLane, smooth: bool): NPolyLine =
   let rast = lane.rast
   let bo = rast.bounds
-  # Prepare Polygon Line
+  let stride = (bo.x1 - bo.x0) shr 8
+  # Prepare Polygon Band Line
+  lane.band = alloc(stride shl 5)
   result = NPolyLine(
     offset: bo.x0,
-    stride: (bo.x1 - bo.x0) shr 8,
-    buffer: rast.buffer.buffer)
+    stride: stride,
+    buffer: lane.band)
   # Prepare Polygon Smooth
   if smooth:
     lane.smooth = alloc(result.stride * 2)
     result.smooth = lane.smooth
 
+proc pack(lane: ptr NPolyLane, y0: int32) =
+  let
+    rast = lane.rast
+    band = cast[ptr UncheckedArray[uint64]](lane.band)
+    cells = cast[ptr UncheckedArray[pointer]](addr rast.cells[0])
+    cols = int(rast.cols)
+    words = cols shl 2
+    row = int((y0 - rast.bounds.y0) shr 13) * cols
+  # Classify Band Tiles
+  for col in 0 ..< cols:
+    var
+      lo = 0'u64
+      hi = high(uint64)
+      idx = col shl 2
+    for _ in 0 ..< 32:
+      for i in idx ..< idx + 4:
+        lo = lo or band[i]
+        hi = hi and band[i]
+      idx += words
+    # Store Full or Partial Tile
+    var cell: pointer = nil
+    if hi == high(uint64):
+      cell = addr polyFull
+    elif lo != 0:
+      cell = allocShared(1024)
+      let tile = cast[ptr UncheckedArray[uint64]](cell)
+      idx = col shl 2
+      for y in 0 ..< 32:
+        copyMem(addr tile[y shl 2], addr band[idx], 32)
+        idx += words
+    cells[row + col] = cell
+
 proc rasterizeSimple(lane: ptr NPolyLane) =
   let skip = lane.skip * 8192
   let offset = lane.offset * 8192
   var line = lane.prepare(smooth = false)
-  polygon_line_skip(addr line, offset)
   # Rasterize by 32
   let rast = lane.rast
   var y0 = rast.bounds.y0 + offset
@@ -334,6 +483,7 @@ proc rasterizeSimple(lane: ptr NPolyLane) =
   while y0 < y2:
     let y1 = y0 + 8192
     lane.gather(y0, y1)
+    polygon_line_skip(addr line, 0)
     # Rasterize Scanline
     var y = y0
     while y < y1:
@@ -349,7 +499,8 @@ proc rasterizeSimple(lane: ptr NPolyLane) =
         polygon_line_simple(addr line)
       # Next Scanline
       polygon_line_next(addr line); y += 256
-    polygon_line_skip(addr line, skip); y0 += skip
+    # Pack Band Tiles
+    lane.pack(y0); y0 += skip
   # Clear Temporals
   lane.clear()
 
@@ -357,7 +508,6 @@ proc rasterizeSmooth(lane: ptr NPolyLane) =
   let skip = lane.skip * 8192
   let offset = lane.offset * 8192
   var line = lane.prepare(smooth = true)
-  polygon_line_skip(addr line, offset)
   # Rasterize by 32
   let rast = lane.rast
   var y0 = rast.bounds.y0 + offset
@@ -365,6 +515,7 @@ proc rasterizeSmooth(lane: ptr NPolyLane) =
   while y0 < y2:
     let y1 = y0 + 8192
     lane.gather(y0, y1)
+    polygon_line_skip(addr line, 0)
     # Rasterize Scanline
     var y = y0
     while y < y1:
@@ -385,7 +536,8 @@ proc rasterizeSmooth(lane: ptr NPolyLane) =
       # Next Scanline
       polygon_line_smooth(addr line)
       polygon_line_next(addr line)
-    polygon_line_skip(addr line, skip)
+    # Pack Band Tiles
+    lane.pack(y0)
     y0 += skip
   # Clear Temporals
   lane.clear()
@@ -395,8 +547,9 @@ proc rasterizeSmooth(lane: ptr NPolyLane) =
 # ---------------------------
 
 proc rasterize*(rast: var NPolygon): NImageBuffer =
-  result = rast.buffer
+  result = default(NImageBuffer)
   let pool = rast.pool
+  rast.release()
   # Rasterizer Mode
   let fn =
     if rast.smooth:
@@ -404,19 +557,26 @@ proc rasterize*(rast: var NPolygon): NImageBuffer =
     else: rasterizeSimple
   # Dispatch Rasterizer
   let bo0 = rast.bounds
-  if clip(rast.bounds, result.w, result.h):
+  if clip(rast.bounds, rast.w, rast.h):
+    rast.table()
+    # Prepare Coverage Grid
+    let bo = addr rast.bounds
+    rast.tx = bo.x0 shr 13
+    rast.ty = bo.y0 shr 13
+    rast.cols = (bo.x1 - bo.x0) shr 13
+    rast.rows = (bo.y1 - bo.y0) shr 13
+    setLen(rast.cells, rast.cols * rast.rows)
     pool.start()
     for lane in rast.lanes:
       pool.spawn(fn, addr lane)
     # Adjust Buffer Dimensions
-    let bo = addr rast.bounds
     result.x = bo.x0 shr 8
     result.y = bo.y0 shr 8
     result.w = (bo.x1 - bo.x0) shr 8
     result.h = (bo.y1 - bo.y0) shr 8
-    result.stride = result.w
+    result.stride = 32
+    result.bpp = 1
     # Wait Threading
     pool.sync()
     pool.stop()
-  else: wasMoved(result)
   rast.bounds = bo0
@@ -11,6 +11,14 @@ type
     pixel {.align: 16.}: uint64
     src: NImageBuffer
     dst: NImageBuffer
+  NPolygonTask = object
+    proxy: ptr NPolygonProxy
+    tiles: ptr NTileImage
+    # Task Tile Row
+    ty, tx0, tx1: cint
+  NPolygonStage = object
+    src {.align: 16.}: array[1024, uint64]
+    dst {.align: 16.}: array[1024, uint64]
   NPolyMode* = enum
     modeMaskBlit
     modeMaskUnion
@@ -23,8 +31,7 @@ type
     ctx: ptr NImageContext
     status: ptr NImageStatus
     pool: NThreadPool
-    # Polygon Buffers
-    map: NImageBuffer
+    # Polygon Coverage
     mask: NImageBuffer
     rast: NPolygon
     layer: NLayer
@@ -83,33 +90,86 @@ proc dstColor(state: ptr NCompositorState): NImageBuffer =
     of tsColor: proxy_uniform_fill(addr co)
     of tsBuffer: proxy_stream(addr co)
 
+proc solid(proxy: ptr NPolygonProxy, mc: var NMaskCombine): uint64 =
+  var pixels {.noinit, align: 16.}: array[8, uint64]
+  let full = proxy.rast.full()
+  # Unpack Full Coverage Once
+  mc.co.src = NImageBuffer(w: 8, h: 1,
+    stride: 32, bpp: 1, buffer: full.buffer)
+  mc.co.dst = NImageBuffer(w: 8, h: 1,
+    stride: 64, bpp: 8, buffer: addr pixels)
+  if proxy.mode != modeColorBlend:
+    polygon_mask_blit(addr mc)
+    result = cast[ptr uint16](addr pixels)[]
+  else:
+    polygon_color_blit16(addr mc)
+    result = pixels[0]
+
+proc fill(dst: NImageBuffer, pixel: uint64) =
+  var row = cast[uint](dst.buffer)
+  # Fill Uniform Coverage Rows
+  for _ in 0 ..< dst.h:
+    if dst.bpp == 2:
+      let line = cast[ptr UncheckedArray[uint16]](row)
+      for x in 0 ..< dst.w: line[x] = uint16(pixel)
+    else:
+      let line = cast[ptr UncheckedArray[uint64]](row)
+      for x in 0 ..< dst.w: line[x] = pixel
+    row += uint(dst.stride)
+
 proc srcColor(state: ptr NCompositorState): NImageBuffer =
   let proxy = cast[ptr NPolygonProxy](state.ext)
   result = pushBuffer(state.stack)
   let lod = state.mipmap
   result.w = result.w shr lod
   result.h = result.h shr lod
-  let clip = NImageClip(
-    x: result.x shr lod,
-    y: result.y shr lod,
-    w: result.w,
-    h: result.h
-  )
-  # Prepare Unpack Polygon Mask
+  let mask = proxy.mask
+  # Clip Polygon Coverage to Block
+  let
+    x0 = max(result.x shr lod, mask.x)
+    y0 = max(result.y shr lod, mask.y)
+    x1 = min((result.x shr lod) + result.w, mask.x + mask.w)
+    y1 = min((result.y shr lod) + result.h, mask.y + mask.h)
+  result.x = x0
+  result.y = y0
+  result.w = max(x1 - x0, 0)
+  result.h = max(y1 - y0, 0)
+  if proxy.mode != modeColorBlend:
+    result.bpp = sizeof(uint16) * 1
+  if result.w == 0 or result.h == 0:
+    return result
+  # Prepare Unpack Polygon Coverage
   var mc {.noinit.}: NMaskCombine
-  mc.co.src = proxy.mask
-  mc.co.dst = result
   mc.alpha = proxy.alpha
   mc.color = proxy.color
-  # Prepare Unpack Polygon Clipping
-  buffer_clip(addr mc.co.src, clip)
-  copyMem(addr result, addr mc.co.src, sizeof NImageClip)
-  mc.co.src.w = max(mc.co.src.w, 8)
-  # Unpack Polygon Mask to Color
-  if proxy.mode != modeColorBlend:
-    result.bpp = sizeof(uint16) * 1
-    polygon_mask_blit(addr mc)
-  else: polygon_color_blit16(addr mc)
+  let pixel = proxy.solid(mc)
+  # Unpack Polygon Coverage Tiles
+  for ty in y0 shr 5 ..< (y1 + 0x1F) shr 5:
+    for tx in x0 shr 5 ..< (x1 + 0x1F) shr 5:
+      let
+        tile = proxy.rast.tile(tx, ty)
+        sx = max(x0, tx shl 5)
+        sy = max(y0, ty shl 5)
+        w = min(x1, (tx + 1) shl 5) - sx
+        h = min(y1, (ty + 1) shl 5) - sy
+        offset = (sy - y0) * result.stride + (sx - x0) * result.bpp
+      var dst = result
+      dst.buffer = cast[pointer](cast[uint](result.buffer) + uint(offset))
+      dst.w = w
+      dst.h = h
+      # Unpack Coverage by Tile Status
+      case tile.status
+      of tsInvalid, tsZero: fill(dst, 0)
+      of tsColor: fill(dst, pixel)
+      of tsBuffer:
+        let src = (sy - ty shl 5) shl 5 + (sx - tx shl 5)
+        mc.co.src = NImageBuffer(x: sx, y: sy,
+          w: max(w, 8), h: h, stride: 32, bpp: 1,
+          buffer: cast[pointer](cast[uint](tile.buffer) + uint(src)))
+        mc.co.dst = dst
+        if proxy.mode != modeColorBlend:
+          polygon_mask_blit(addr mc)
+        else: polygon_color_blit16(addr mc)
 
 proc prepareColor(state: ptr NCompositorState): NImageBuffer =
   let proxy = cast[ptr NPolygonProxy](state.ext)
@@ -180,9 +240,9 @@ proc prepare*(proxy: var NPolygonProxy, layer: NLayer) =
   layer.hook.ext = addr proxy
   proxy.layer = layer
   echo "hooked layer: ", layer.props.label
-  # Prepare Proxy Buffer
-  proxy.map = proxy.ctx[].mapAux(1)
-  proxy.rast.configure(proxy.pool, proxy.map)
+  # Prepare Proxy Rasterizer
+  let ctx = proxy.ctx
+  proxy.rast.configure(proxy.pool, ctx.w32, ctx.h32)
   proxy.rast.clear()
 
 # ----------------------------------
@@ -225,13 +285,162 @@ proc rasterize*(proxy: var NPolygonProxy) =
 # Polygon Proxy Composite: Commit
 # -------------------------------
 
-# IMPORTANT TODO: multithreading
+proc source(proxy: ptr NPolygonProxy,
+    cover: NPolyTile; tx, ty: cint): NMaskCombine =
+  result.alpha = proxy.alpha
+  result.color = proxy.color
+  # Locate Polygon Coverage Tile
+  result.co.src = NImageBuffer(
+    x: tx shl 5, y: ty shl 5,
+    w: 32, h: 32, stride: 32, bpp: 1,
+    buffer: cover.buffer)
+
+proc expand(tile: var NTile) =
+  let
+    color = tile.data.color
+    status = tile.status
+  if status == tsBuffer:
+    return
+  tile.toBuffer()
+  let buffer = tile.data.buffer
+  if status < tsColor:
+    zeroMem(buffer, tile.bytes)
+    return
+  # Expand Uniform Pixel to Tile Depth
+  case tile.bpp
+  of 2:
+    let pixels = cast[ptr UncheckedArray[uint16]](buffer)
+    for i in 0 ..< 1024: pixels[i] = uint16(color and 0xFFFF)
+  of 4:
+    var pixel: uint32
+    for c in 0 ..< 4:
+      let channel = (color shr (c * 16 + 8)) and 0xFF
+      pixel = pixel or uint32(channel shl (c * 8))
+    let pixels = cast[ptr UncheckedArray[uint32]](buffer)
+    for i in 0 ..< 1024: pixels[i] = pixel
+  else:
+    let pixels = cast[ptr UncheckedArray[uint64]](buffer)
+    for i in 0 ..< 1024: pixels[i] = color
+
+proc uniform(tile: var NTile, co: var NImageCombine) =
+  tile.toBuffer()
+  co.dst = tile.chunk()
+  proxy_uniform_stream(addr co)
+  # Check Tile Uniform
+  if co.dst.bpp == co.dst.stride:
+    tile.toColor(co.dst.pixel)
+  else: tile.mipmaps()
+
+proc direct(proxy: ptr NPolygonProxy, tile: var NTile, mc: var NMaskCombine) =
+  let eight = tile.bpp == 4
+  tile.expand()
+  mc.co.dst = tile.chunk()
+  # Combine Polygon Mask into Tile
+  case proxy.mode
+  of modeMaskBlit: polygon_mask_blit(addr mc)
+  of modeMaskUnion: polygon_mask_union(addr mc)
+  of modeMaskExclude: polygon_mask_exclude(addr mc)
+  of modeMaskIntersect: polygon_mask_intersect(addr mc)
+  of modeColorBlend:
+    if eight: polygon_color_blend8(addr mc)
+    else: polygon_color_blend16(addr mc)
+  of modeColorErase:
+    if eight: polygon_color_erase8(addr mc)
+    else: polygon_color_erase16(addr mc)
+  # Collapse Uniform Tile
+  var co = combine(mc.co.dst, mc.co.dst)
+  tile.uniform(co)
+
+proc staging(proxy: ptr NPolygonProxy, tile: var NTile, mc: var NMaskCombine) =
+  var
+    stage {.noinit.}: NPolygonStage
+    co {.noinit.}: NImageComposite
+  let
+    src = NImageBuffer(x: tile.x shl 5, y: tile.y shl 5,
+      w: 32, h: 32, stride: 256, bpp: 8, buffer: addr stage.src)
+    dst = NImageBuffer(x: src.x, y: src.y,
+      w: 32, h: 32, stride: 256, bpp: 8, buffer: addr stage.dst)
+  # Stream Tile to Staging
+  var c = combine(tile.chunk(), dst)
+  case tile.status
+  of tsInvalid, tsZero: combine_clear(addr c)
+  of tsColor: proxy_uniform_fill(addr c)
+  of tsBuffer:
+    if tile.bpp == 4: proxy_stream8(addr c)
+    else: proxy_stream16(addr c)
+  # Blend Polygon Color to Staging
+  mc.co.dst = src
+  polygon_color_blit16(addr mc)
+  co.src = src
+  co.dst = dst
+  co.alpha = 65535
+  co.clip = 0
+  co.fn = blend_procs[proxy.blend]
+  blendChunk(addr co)
+  # Pack Staging to Tile Depth
+  c = combine(dst, dst)
+  if tile.bpp == 4:
+    mipmap_pack8(addr c)
+    c.src.bpp = tile.bpp
+  tile.uniform(c)
+
+proc mt_commit(task: ptr NPolygonTask) =
+  let
+    proxy = task.proxy
+    tiles = task.tiles
+    ty = task.ty
+    # Advanced Blending Needs Staging
+    stage = proxy.mode == modeColorBlend and
+      proxy.blend > bmStencil
+  # Commit Each Tile of Row
+  for tx in task.tx0 ..< task.tx1:
+    let cover = proxy.rast.tile(tx, ty)
+    var tile = tiles[].find(tx, ty)
+    # Skip Uncovered Tiles
+    if cover.status < tsColor:
+      if proxy.mode in {modeMaskBlit, modeMaskIntersect}:
+        tile.toColor(0)
+      continue
+    var mc = proxy.source(cover, tx, ty)
+    if stage: proxy.staging(tile, mc)
+    else: proxy.direct(tile, mc)
+
+proc dispatch(proxy: var NPolygonProxy) =
+  let
+    mask = proxy.mask
+    tiles = addr proxy.layer.tiles
+    color = proxy.mode >= modeColorBlend
+  # Check Polygon Mode Matches Layer
+  if mask.w <= 0 or mask.h <= 0 or
+      color == (proxy.layer.kind == lkMask):
+    return
+  let
+    tx0 = mask.x shr 5
+    ty0 = mask.y shr 5
+    tx1 = (mask.x + mask.w + 0x1F) shr 5
+    ty1 = (mask.y + mask.h + 0x1F) shr 5
+    pool = proxy.pool
+  tiles[].ensure(tx0, ty0, tx1 - tx0, ty1 - ty0)
+  # Prepare Tile Row Tasks
+  var tasks = newSeq[NPolygonTask](ty1 - ty0)
+  for i, task in mpairs(tasks):
+    task.proxy = addr proxy
+    task.tiles = tiles
+    task.ty = ty0 + cint(i)
+    task.tx0 = tx0
+    task.tx1 = tx1
+  # Commit Tile Rows in Parallel
+  pool.start()
+  for task in mitems(tasks):
+    pool.spawn(mt_commit, addr task)
+  pool.sync()
+  pool.stop()
+
 proc commit*(proxy: var NPolygonProxy) =
-  let mask = proxy.mask
-  # Clear Buffer Auxiliar and Layer Hook
+  proxy.dispatch()
+  # Clear Coverage Tiles and Layer Hook
   proxy.layer.hook = default(NLayerHook)
-  proxy.ctx[].clearAux()
+  proxy.rast.release()
   # Remove Mappings
-  wasMoved(proxy.map)
   wasMoved(proxy.mask)
   wasMoved(proxy.layer)
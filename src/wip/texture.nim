@@ -1,115 +1,91 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 # Copyright (c) 2021 Cristian Camilo Ruiz <mrgaturus>
 from math import log2
+from hashes import Hash, hash
+import nogui/async/pool
+# Import SIMD Mipmap Downscale
+{.compile: "texture/mipmap.c".}
+proc texture_downscale(src, dst: pointer; w, h: cint) {.importc.}
 
 type
   NMipmap = object
     w, h, offset: cint
+  NTextureStatus = enum
+    txPending, txHashed
+    txLoaded, txMissing
   NTexture* = object
     # Buffer Size
     w, h, bytes: cint
+    serial: int
     # Mipmapped Texture
     levels: seq[NMipmap]
     buffer: seq[uint8]
-  NTextureMap = ptr UncheckedArray[uint8]
+    # Lazy Texture Source
+    cache: NTextureCache
+    status: NTextureStatus
+    alias: ptr NTexture
+    # Texture File Content
+    file: string
+    hash: Hash
+    size: int
+  NTextureCache* = ptr object
+    pool: NThreadPool
+    textures: seq[ptr NTexture]
+    # Cache Counters
+    loads*, shared*: int
   NTextureRaw* = object
     w*, h*, level*: cint
+    serial*: int
     # Buffer Pointer
     buffer*: pointer
 
+# Texture Serials Never Reused by Freed Textures
+var serials: int
+
 # -----------------------------------------
 # TEXTURE GRAYSCALE MIPMAP GENERATION PROCS
 # -----------------------------------------
 
-proc average(tex: NTextureRaw, x, y: cint): uint8 =
-  let
-    w = tex.w
-    h = tex.h
-    # Pixel Buffer Mapping
-    map = cast[NTextureMap](tex.buffer)
-  var 
-    pixel: cint
-    # Current Cursor
-    c1, c0 = y * w + x
-    next = cint(x < w - 1)
-  # Step Y Position
-  if y < h - 1: c1 += w
-  # Sum Pixel Neighbours
-  pixel += cast[cint](map[c0 + 0])
-  pixel += cast[cint](map[c0 + next])
-  pixel += cast[cint](map[c1 + 0])
-  pixel += cast[cint](map[c1 + next])
-  # Return Averaged Pixel
-  result = cast[uint8](pixel shr 2)
-
-proc downscale(tex: NTextureRaw, map: NTextureMap): cint =
-  let
-    sw = max(tex.w shr 1, 1)
-    sh = max(tex.h shr 1, 1)
-  var pixel: uint8
-  for y in 0 ..< sh:
-    for x in 0 ..< sw:
-      let
-        xx = x shl 1
-        yy = y shl 1
-      pixel = average(tex, xx, yy)
-      map[result] = pixel
-      # Step Pixel
-      inc(result)
-
 proc mipmaps(tex: var NTexture) =
-  var 
-    mip: NMipmap
-    # Texture Accesor
-    raw: NTextureRaw
-    map: NTextureMap
-    # Buffer Size
-    w = tex.w
-    h = tex.h
-    offset = w * h
-  # Add First Offset
-  mip.w = w
-  mip.h = h
-  mip.offset = 0
+  var
+    mip = NMipmap(w: tex.w, h: tex.h)
+    # Next Level Offset
+    offset = tex.w * tex.h
+  # Add First Level
   tex.levels.add(mip)
-  # Initialize Accesor
-  raw.w = w
-  raw.h = h
-  raw.buffer = addr tex.buffer[0]
-  # Initialize Buffer Target Mapping
-  map = cast[NTextureMap](addr tex.buffer[offset])
   # Create Each Mipmap
-  while w > 1 and h > 1:
-    mip.offset = offset
-    offset += downscale(raw, map)
+  while mip.w > 1 and mip.h > 1:
+    let
+      src = addr tex.buffer[mip.offset]
+      dst = addr tex.buffer[offset]
+    texture_downscale(src, dst, mip.w, mip.h)
     # Reduce Mipmap by One
-    w = max(w shr 1, 1)
-    h = max(h shr 1, 1)
-    # Set Current Mipmap
-    mip.w = w
-    mip.h = h
+    mip.w = max(mip.w shr 1, 1)
+    mip.h = max(mip.h shr 1, 1)
+    mip.offset = offset
     tex.levels.add(mip)
-    # Set Current Accesor
-    raw.w = w
-    raw.h = h
-    raw.buffer = map
-    # Step Buffet Target Mapping
-    map = cast[NTextureMap](addr tex.buffer[offset])
+    # Step Buffer Offset
+    offset += mip.w * mip.h
 
 # -----------------------------------
 # TEXTURE ACCESSOR MANIPULATION PROCS
 # -----------------------------------
 
+proc resolve(tex: ptr NTexture): ptr NTexture
+
 proc raw*(tex: ptr NTexture): NTextureRaw =
+  let tex = resolve(tex)
   # Set Current Accesor
   result.w = tex.w
   result.h = tex.h
   result.buffer = addr tex.buffer[0]
   # Set Current Level
   result.level = 0
+  result.serial = tex.serial
 
 proc raw*(tex: ptr NTexture, scale: cfloat): NTextureRaw =
-  let 
+  let
+    tex = resolve(tex)
     level = max(0, -log2(scale).cint)
     mip = addr tex.levels[level]
   # Set Current Accesor
@@ -118,6 +94,7 @@ proc raw*(tex: ptr NTexture, scale: cfloat): NTextureRaw =
   result.buffer = addr tex.buffer[mip.offset]
   # Set Current Level
   result.level = level
+  result.serial = tex.serial
 
 # ----------------------
 # TEXTURE CREATION PROCS
@@ -135,6 +112,8 @@ proc newTexture*(w, h: cint, buffer: seq[uint8]): NTexture =
   result.h = h
   # Calculate Mipmaps
   result.mipmaps()
+  result.status = txLoaded
+  result.serial = atomicInc(serials)
 
 # ------------------------------------
 # DEBUG PROOF OF CONCEPT TESTING PROCS
@@ -144,6 +123,7 @@ import nogui/libs/png
 proc newPNGTexture*(file: string): NTexture =
   let png = createReadPNG(file)
   if not png.readRGBA():
+    result.status = txMissing
     return
   let
     w = cast[cint](png.w)
@@ -168,6 +148,128 @@ proc newPNGTexture*(file: string): NTexture =
   result = newTexture(w, h, buffer)
   png.close()
 
+# --------------------------
+# TEXTURE CACHE LAZY LOADING
+# --------------------------
+
+proc digest(tex: ptr NTexture) =
+  try:
+    let data = readFile(tex.file)
+    # Hash File Content
+    tex.hash = hash(data)
+    tex.size = len(data)
+    tex.status = txHashed
+  except IOError:
+    tex.status = txMissing
+
+proc decode(tex: ptr NTexture) =
+  var source: NTexture
+  # Keep Texture Source
+  source.cache = tex.cache
+  source.hash = tex.hash
+  source.size = tex.size
+  swap(source.file, tex.file)
+  # Decode Texture File
+  tex[] = newPNGTexture(source.file)
+  if tex.status == txMissing:
+    echo "[WARNING] failed load texture: ", source.file
+    tex[] = newTexture(1, 1, @[0'u8])
+  # Restore Texture Source
+  tex.cache = source.cache
+  tex.hash = source.hash
+  tex.size = source.size
+  swap(source.file, tex.file)
+
+proc same(a, b: ptr NTexture): bool =
+  # Compare Content Bytes After Hash Match
+  try: result = readFile(a.file) == readFile(b.file)
+  except IOError: result = false
+
+proc share(tex: ptr NTexture) =
+  var prior = true
+  # Find Same Content Texture
+  for t in tex.cache.textures:
+    if t == tex:
+      prior = false
+      continue
+    let check = (prior and t.status == txHashed) or t.status == txLoaded
+    if check and isNil(t.alias) and t.size == tex.size and
+        t.hash == tex.hash and same(t, tex):
+      tex.alias = t
+      tex.status = txLoaded
+      inc(tex.cache.shared)
+      return
+
+proc resolve(tex: ptr NTexture): ptr NTexture =
+  result = tex
+  # Load Texture Lazily
+  if tex.status == txPending:
+    tex.digest()
+  if tex.status == txHashed:
+    tex.share()
+  if not isNil(tex.alias):
+    result = tex.alias
+  # Decode Texture Content
+  if result.status in {txHashed, txMissing}:
+    result.decode()
+    inc(tex.cache.loads)
+
+# ------------------------
+# TEXTURE CACHE PRELOADING
+# ------------------------
+
+proc mt_digest(tex: ptr NTexture) =
+  tex.digest()
+
+proc mt_decode(tex: ptr NTexture) =
+  tex.decode()
+
+proc preload*(cache: NTextureCache) =
+  let pool = cache.pool
+  pool.start()
+  # Hash Pending Textures
+  for tex in cache.textures:
+    if tex.status == txPending:
+      pool.spawn(mt_digest, tex)
+  pool.sync()
+  # Share Same Content Textures
+  for tex in cache.textures:
+    if tex.status == txHashed:
+      tex.share()
+  # Decode Unique Textures
+  for tex in cache.textures:
+    if tex.status in {txHashed, txMissing} and isNil(tex.alias):
+      pool.spawn(mt_decode, tex)
+      inc(cache.loads)
+  pool.sync()
+  pool.stop()
+
+# ------------------------------
+# TEXTURE CACHE CREATION/DESTROY
+# ------------------------------
+
+proc createTextureCache*(pool: NThreadPool): NTextureCache =
+  result = create(result[].typeof)
+  result.pool = pool
+
+proc destroy*(cache: NTextureCache) =
+  for tex in cache.textures:
+    `=destroy`(tex[])
+    dealloc(tex)
+  # Dealloc Texture Cache
+  `=destroy`(cache[])
+  dealloc(cache)
+
+proc texture*(cache: NTextureCache, file: string): ptr NTexture =
+  for tex in cache.textures:
+    if tex.file == file:
+      return tex
+  # Register Pending Texture
+  result = create(NTexture)
+  result.cache = cache
+  result.file = file
+  cache.textures.add(result)
+
 #[
 proc debug*(tex: NTexture, file: string) =
   var buffer: seq[uint8]
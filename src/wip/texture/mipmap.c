@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+#include <smmintrin.h>
+
+// ----------------------------------
+// TEXTURE GRAYSCALE MIPMAP DOWNSCALE
+// ----------------------------------
+
+void texture_downscale(unsigned char* src, unsigned char* dst, int w, int h) {
+  // Downscaled Dimensions
+  const int sw = (w >> 1) > 1 ? (w >> 1) : 1;
+  const int sh = (h >> 1) > 1 ? (h >> 1) : 1;
+  // Neighbour Steps
+  const int next = (w > 1);
+  const int stride = (h > 1) ? w : 0;
+
+  __m128i xmm0, xmm1, xmm2, xmm3;
+  // Horizontal Pair Summation
+  const __m128i ones = _mm_set1_epi8(1);
+
+  for (int y = 0; y < sh; y++) {
+    unsigned char* row0 = src + (y << 1) * w;
+    unsigned char* row1 = row0 + stride;
+    int x = 0;
+
+    // Average Sixteen Pixels
+    if (next) for (; x + 16 <= sw; x += 16) {
+      xmm0 = _mm_loadu_si128((__m128i*) (row0 + (x << 1)));
+      xmm1 = _mm_loadu_si128((__m128i*) (row0 + (x << 1) + 16));
+      xmm2 = _mm_loadu_si128((__m128i*) (row1 + (x << 1)));
+      xmm3 = _mm_loadu_si128((__m128i*) (row1 + (x << 1) + 16));
+      // Sum Horizontal Pairs
+      xmm0 = _mm_maddubs_epi16(xmm0, ones);
+      xmm1 = _mm_maddubs_epi16(xmm1, ones);
+      xmm2 = _mm_maddubs_epi16(xmm2, ones);
+      xmm3 = _mm_maddubs_epi16(xmm3, ones);
+      // Sum Vertical Pairs
+      xmm0 = _mm_add_epi16(xmm0, xmm2);
+      xmm1 = _mm_add_epi16(xmm1, xmm3);
+      // Average and Pack
+      xmm0 = _mm_srli_epi16(xmm0, 2);
+      xmm1 = _mm_srli_epi16(xmm1, 2);
+      xmm0 = _mm_packus_epi16(xmm0, xmm1);
+      _mm_storeu_si128((__m128i*) dst, xmm0);
+      // Step Sixteen Pixels
+      dst += 16;
+    }
+
+    // Average Remaining Pixels
+    for (; x < sw; x++) {
+      const int xx = x << 1;
+      int pixel = row0[xx] + row0[xx + next];
+      pixel += row1[xx] + row1[xx + next];
+      // Store Averaged Pixel
+      *(dst++) = pixel >> 2;
+    }
+  }
+}
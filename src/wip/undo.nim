@@ -1,17 +1,36 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 # Copyright (c) 2024 Cristian Camilo Ruiz <mrgaturus>
 import nogui/async/core
+from std/monotimes import getMonoTime, ticks
 import undo/[book, cmd, stream, swap]
-import image/layer
+import image/[layer, tiles]
 import image
 # Export Undo Command Enum
 export NUndoCommand
 export NUndoEffect
+# Export Undo Compression Stats
+export NUndoStats, throughput, ratio
 
 type
-  NUndoWhere = enum
+  NUndoLearn = object
+    undo: NImageUndo
+    # Dictionary Samples
+    samples: seq[byte]
+    sizes: seq[csize_t]
+    level: cint
+  # Undo Step Location
+  NUndoWhere* = enum
     inRAM, inStage
     inTrash, inSwap
+  NUndoReport* = object
+    cmd*: NUndoCommand
+    msg*: uint32
+    where*: NUndoWhere
+    # Resident and Swap Bytes
+    bytes*, packed*: int64
+    # Accumulated Nanoseconds
+    capture*, compress*: int64
+    spill*, restore*: int64
   NUndoChain = enum
     chainNone
     chainStart
@@ -32,6 +51,7 @@ type
     chain: NUndoChain
     cmd: NUndoCommand
     data: NUndoData
+    report: NUndoReport
   # Undo Step Manager
   NUndoTask = object
     undo: NImageUndo
@@ -44,6 +64,8 @@ type
     stream: NUndoStream
     state: NUndoState
     coro: Coroutine[NUndoTask]
+    learn: Coroutine[NUndoLearn]
+    image: NImage
     # Step Linked List
     first, last: NUndoStep
     firs0, las0: NUndoStep
@@ -53,33 +75,197 @@ type
     # Step Cursor Status
     busy, bus0: bool
     swipe: bool
+    # Swap Size Budget
+    budget: int64
+    # Resident Size Budget
+    memory: int64
+    spilled: seq[NUndoReport]
+    # Dictionary Training
+    dict, trained: bool
 
 # ---------------------------------
 # Undo Manager Creation/Destruction
 # ---------------------------------
 
-proc createImageUndo*(image: NImage): NImageUndo =
+proc createImageUndo*(image: NImage, dir: string, budget: int64): NImageUndo =
   result = create(result[].typeof)
   let swap = addr result.swap
   let stream = addr result.stream
   let coro = coroutine(NUndoTask)
   # Configure Streaming
-  swap[].configure()
+  swap[].configure(dir)
   stream[].configure(swap)
+  result.budget = budget
   # Configure Dispatchers
   configure(result.state, stream, image)
   configure(coro.data.state, stream)
   # Configure Coroutine Task
   coro.data.undo = result
   result.coro = coro
+  # Configure Dictionary Task
+  let learn = coroutine(NUndoLearn)
+  learn.data.undo = result
+  result.learn = learn
+  result.image = image
 
 proc destroy*(undo: NImageUndo) =
+  # Join Dictionary Training
+  undo.learn.wait()
   destroy(undo.stream)
   destroy(undo.swap)
   # Dealloc Undo History
   `=destroy`(undo[])
   dealloc(undo)
 
+# ------------------------
+# Undo Manager Compression
+# ------------------------
+
+proc compression*(undo: NImageUndo, level, workers: cint) =
+  undo.coro.lock():
+    undo.stream.compression(level, workers)
+
+proc stats*(undo: NImageUndo): NUndoStats =
+  undo.coro.lock():
+    result = undo.stream.stats
+
+proc statsDict*(undo: NImageUndo): NUndoStats =
+  undo.coro.lock():
+    result = undo.stream.statsDict
+
+# -----------------------
+# Undo Manager Dictionary
+# -----------------------
+
+const
+  # Dictionary Training Budget
+  learnThreshold = 64 shl 20
+  learnSamples = 1024
+  learnBytes = 112 shl 10
+
+iterator layers(root: NLayer): NLayer =
+  var layer = root.first
+  while not isNil(layer):
+    yield layer
+    # Enter/Leave Folder
+    if layer.kind == lkFolder and not isNil(layer.first):
+      layer = layer.first
+      continue
+    while isNil(layer.next) and layer.folder != root:
+      layer = layer.folder
+    # Step Next Layer
+    layer = layer.next
+
+proc sample(task: ptr NUndoLearn, root: NLayer) =
+  var count: int
+  for layer in root.layers:
+    if layer.kind == lkColor16:
+      for tile in layer.tiles:
+        count += int(tile.status == tsBuffer)
+  # Sample Tiles Evenly
+  let step = count div learnSamples + 1
+  var idx: int
+  for layer in root.layers:
+    if layer.kind != lkColor16: continue
+    for tile in layer.tiles:
+      if tile.status != tsBuffer: continue
+      if idx mod step == 0:
+        let l = len(task.samples)
+        setLen(task.samples, l + tile.bytes)
+        copyMem(addr task.samples[l], tile.data.buffer, tile.bytes)
+        task.sizes.add csize_t(tile.bytes)
+      inc(idx)
+
+proc learn0clean(task: ptr NUndoLearn) =
+  # Release Dictionary Samples
+  `=destroy`(task.samples)
+  `=destroy`(task.sizes)
+  wasMoved(task.samples)
+  wasMoved(task.sizes)
+
+proc learn0coro(coro: Coroutine[NUndoLearn]) =
+  let task = coro.data
+  let undo = task.undo
+  # Train Dictionary Outside Lock
+  let dict = train(task.samples,
+    task.sizes, learnBytes, task.level)
+  # Release Samples Before Install
+  task.learn0clean()
+  undo.coro.lock():
+    undo.stream.install(dict)
+
+proc train*(undo: NImageUndo) =
+  let task = undo.learn.data
+  if len(task.sizes) > 0: return
+  # Sample Current Document Tiles
+  task.sample(undo.image.root)
+  task.level = undo.stream.level
+  undo.trained = true
+  if len(task.sizes) == 0:
+    return
+  # Train Dictionary in Background
+  undo.learn.setProc(learn0coro)
+  undo.learn.spawn()
+
+proc dictionary*(undo: NImageUndo, enabled: bool) =
+  undo.dict = enabled
+  undo.coro.lock():
+    undo.stream.dict = enabled
+
+proc learn0check(undo: NImageUndo) =
+  if not undo.dict or undo.trained:
+    return
+  # Train When Enough Data Was Compressed
+  var bytes: int64
+  undo.coro.lock():
+    bytes = undo.stream.stats.bytesIn
+  if bytes >= learnThreshold:
+    undo.train()
+
+# --------------------
+# Undo Manager Reports
+# --------------------
+
+const
+  # Spilled Step Reports
+  reportCap = 256
+
+proc memory*(undo: NImageUndo, budget: int64) =
+  undo.memory = max(budget, 0)
+
+proc report(step: NUndoStep): NUndoReport =
+  result = step.report
+  result.cmd = step.cmd
+  result.msg = step.msg
+  result.where = step.where
+
+proc reports*(undo: NImageUndo): seq[NUndoReport] =
+  result = undo.spilled
+  # Report Current Steps
+  var step = undo.first
+  while not isNil(step):
+    result.add step.report()
+    step = step.next
+
+proc resident*(undo: NImageUndo): int64 =
+  var step = undo.first
+  while not isNil(step):
+    if step.where != inSwap:
+      result += step.report.bytes
+    step = step.next
+
+proc archive(undo: NImageUndo, step: NUndoStep, idx: int) =
+  var report = step.report()
+  report.where = inSwap
+  undo.spilled.insert(report, idx)
+
+proc archived(undo: NImageUndo) =
+  let spilled = addr undo.spilled
+  let l = len(spilled[])
+  # Keep Recent Spilled Reports
+  if l > reportCap:
+    spilled[].delete(0 ..< l - reportCap)
+
 # ---------------------
 # Undo Step Destruction
 # ---------------------
@@ -217,11 +403,16 @@ proc pass(step: NUndoStep): NUndoPass =
 
 proc capture0(step: NUndoStep, layer: NLayer) =
   let state0 = addr step.undo.state
+  let t0 = ticks getMonoTime()
   step.layer = layer.code.id
   # Dispatch Capture Stage
   state0.step = step.pass()
   state0[].tiles(layer)
   state0[].capture()
+  # Accumulate Capture Report
+  let report = addr step.report
+  report.capture += ticks(getMonoTime()) - t0
+  report.bytes = bytes(step.data, step.cmd)
 
 proc child(step: NUndoStep, layer: NLayer, rev: bool): NUndoStep =
   result = create(result[].typeof)
@@ -310,11 +501,19 @@ proc swapHeader(task: ptr NUndoTask) =
   stream.writeNumber(uint16 step.chain)
   stream.writeNumber(uint16 step.weak)
 
+proc counters(stream: ptr NUndoStream): tuple[nanos, bytes: int64] =
+  let s0 = addr stream.stats
+  let s1 = addr stream.statsDict
+  result.nanos = s0.nanos + s1.nanos
+  result.bytes = s0.bytesOut + s1.bytesOut
+
 proc swapStage(coro: Coroutine[NUndoTask]): bool =
   let task = coro.data
   let state = addr task.state
+  let step = task.cursor
+  let t0 = ticks getMonoTime()
+  let c0 = counters(state.stream)
   coro.lock():
-    let step = task.cursor
     let stage = task.stage
     state[].step = step.pass0()
     state[].step.stage = stage
@@ -323,9 +522,15 @@ proc swapStage(coro: Coroutine[NUndoTask]): bool =
     result = state[].swap0write()
     inc(task.stage)
   # Dispatch Write Pages
-  if not result: return result
-  while compressPage(state.codec):
-    coro.pass()
+  if result:
+    while compressPage(state.codec):
+      coro.pass()
+  # Accumulate Spill Report
+  let c1 = counters(state.stream)
+  let report = addr step.report
+  report.spill += ticks(getMonoTime()) - t0
+  report.compress += c1.nanos - c0.nanos
+  report.packed += c1.bytes - c0.bytes
 
 proc swapNext(coro: Coroutine[NUndoTask]): bool =
   let task = coro.data; coro.lock():
@@ -338,6 +543,10 @@ proc swapNext(coro: Coroutine[NUndoTask]): bool =
     task.cursor = next
     task.stage = 0
 
+proc swapCompact(coro: Coroutine[NUndoTask]) =
+  let task = coro.data; coro.lock():
+    task.undo.swap.compact()
+
 proc swap0clean(undo: NImageUndo)
 proc swap0coro(coro: Coroutine[NUndoTask]) =
   let task = coro.data
@@ -345,6 +554,8 @@ proc swap0coro(coro: Coroutine[NUndoTask]) =
     if coro.swapStage(): continue
     elif coro.swapNext(): coro.pass()
     else: break
+  # Release Evicted Swap
+  coro.swapCompact()
   # Send Termination Callback
   coro.send CoroCallback(
     data: cast[pointer](task.undo),
@@ -355,18 +566,20 @@ proc swap0coro(coro: Coroutine[NUndoTask]) =
 # Undo Step Coroutine: Ghosting
 # -----------------------------
 
-proc swap0stage(undo: NImageUndo, curso0: NUndoStep) =
+proc swap0stage(undo: NImageUndo, curso0, last0: NUndoStep) =
   undo.firs0 = undo.first
-  undo.las0 = undo.last
+  undo.las0 = last0
   # Ghost Current Stack
   var step = curso0
-  while not isNil(step):
+  while true:
     step.nex0 = step.next
     step.pre0 = step.prev
     step.where = inStage
     # Next Undo Step
+    if step == last0: break
     step = step.next
   wasMoved(curso0.pre0)
+  wasMoved(last0.nex0)
   curso0.skip = undo.peak
   # Configure Coroutine
   let task = undo.coro.data
@@ -379,20 +592,25 @@ proc swap0stage(undo: NImageUndo, curso0: NUndoStep) =
 
 proc swap0check(undo: NImageUndo) =
   var step = default(NUndoStep)
+  var stop = default(NUndoStep)
   var peek = undo.last
+  var bytes: int64
   # Check Busy Indicator
   undo.bus0 = false
   if undo.busy:
     return
-  # Select First inRAM
+  # Select First inRAM and Last Outside Budget
   while not isNil(peek):
-    if peek.where == inRAM:
-      step = peek
-      peek = peek.prev
-    else: break
-  # Dispatch Coroutine  
-  if not isNil(step):
-    undo.swap0stage(step)
+    if peek.where != inRAM: break
+    bytes += peek.report.bytes
+    if isNil(stop) and bytes >= undo.memory and
+        peek.chain in {chainNone, chainEnd}:
+      stop = peek
+    step = peek
+    peek = peek.prev
+  # Dispatch Coroutine
+  if not isNil(stop):
+    undo.swap0stage(step, stop)
 
 proc swap0ghost(undo: NImageUndo, step: NUndoStep) =
   var ghost = undo.first
@@ -419,7 +637,46 @@ proc swap0ghost(undo: NImageUndo, step: NUndoStep) =
     ghost.skip = step.skip
     ghost.chain = step.chain
 
-# TODO: allow keep some steps in RAM
+proc swap0peek(undo: NImageUndo, pos: int64): tuple[skip: NUndoSkip, inner: bool] =
+  let stream = addr undo.stream
+  result.skip = stream.swap[].setRead(pos)
+  # Skip Step Description
+  discard readNumber[uint32](stream)
+  discard readNumber[uint32](stream)
+  discard readNumber[uint32](stream)
+  # Check Step Inside Chain
+  let chain = cast[NUndoChain](readNumber[uint16](stream))
+  result.inner = chain in {chainStep, chainEnd}
+
+proc swap0evict(undo: NImageUndo) =
+  let ghost = undo.first
+  let swap = addr undo.swap
+  if undo.budget <= 0 or isNil(ghost) or
+      ghost.where != inSwap:
+    return
+  # Evict Oldest Steps Outside Budget
+  var floor = swap.floor
+  while undo.peak.pos - floor > undo.budget:
+    var pos = floor
+    while true:
+      let skip = undo.swap0peek(pos).skip
+      if skip.next == skip.pos:
+        break
+      # Stop at Chain Boundary
+      pos = skip.next
+      if not undo.swap0peek(pos).inner:
+        break
+    # Keep Current Ghost Reachable
+    if pos == floor or pos > ghost.skip.pos:
+      break
+    floor = pos
+  # Detach Evicted Steps
+  if floor != swap.floor:
+    swap[].patchPrev(floor)
+    if ghost.skip.pos == floor:
+      ghost.skip.prev = floor
+    swap.floor = floor
+
 proc swap0clean(undo: NImageUndo) =
   var step = undo.las0
   wasMoved(undo.las0)
@@ -435,10 +692,15 @@ proc swap0clean(undo: NImageUndo) =
     undo.peak = predictNext(step.skip)
     undo.swap0ghost(step)
     # Destroy Stage Steps
+    let idx = len(undo.spilled)
     while not isNil(step):
       let pre0 = step.pre0
+      undo.archive(step, idx)
       step.destroy()
       step = pre0
+    undo.archived()
+    # Evict Outside Budget
+    undo.swap0evict()
   # Stage Swap Again
   undo.swap0check()
 
@@ -518,6 +780,8 @@ proc flush*(undo: NImageUndo) =
   undo.busy = false
   if not undo.bus0:
     swap0check(undo)
+  # Train Dictionary if Enabled
+  undo.learn0check()
 
 proc undo*(undo: NImageUndo): set[NUndoEffect] =
   let coro {.cursor.} = undo.coro
@@ -526,6 +790,7 @@ proc undo*(undo: NImageUndo): set[NUndoEffect] =
   while true:
     let step = undo.prevStep()
     if isNil(step): break
+    let t0 = ticks getMonoTime()
     # Process Undo Step
     if step.where != inSwap:
       result.incl effect(step.cmd)
@@ -539,6 +804,7 @@ proc undo*(undo: NImageUndo): set[NUndoEffect] =
       undo.state.undo()
       # Destroy Temporal Data
       destroy(step.data, step.cmd)
+    step.report.restore += ticks(getMonoTime()) - t0
     # Check Undo Step Chain
     if step.chain in {chainNone, chainStart}:
       break
@@ -550,6 +816,7 @@ proc redo*(undo: NImageUndo): set[NUndoEffect] =
   while true:
     let step = undo.nextStep()
     if isNil(step): break
+    let t0 = ticks getMonoTime()
     # Process Redo Step
     if step.where != inSwap:
       result.incl effect(step.cmd)
@@ -563,6 +830,7 @@ proc redo*(undo: NImageUndo): set[NUndoEffect] =
       undo.state.redo()
       # Destroy Temporal Data
       destroy(step.data, step.cmd)
+    step.report.restore += ticks(getMonoTime()) - t0
     # Check Redo Step Chain
     if step.chain in {chainNone, chainEnd}:
       break
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright (c) 2025 Cristian Camilo Ruiz <mrgaturus>
+// Frame Progression Reports Job Count
+#define ZSTD_STATIC_LINKING_ONLY
+#include <zstd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Undo Stream Page Size
+#define PAGE (128 << 10)
+// Synthetic Book Size
+#define BOOK (96 << 20)
+
+// ---------------------------
+// SYNTHETIC UNDO BOOK CONTENT
+// ---------------------------
+
+static unsigned char* book_create() {
+  unsigned short* book = malloc(BOOK);
+  unsigned int seed = 0x9E3779B9;
+  int count = BOOK / (32 * 32 * 8);
+
+  // Fill 16-bit RGBA Tiles
+  for (int t = 0; t < count; t++) {
+    unsigned short* tile = book + t * 32 * 32 * 4;
+    // Keep Some Tiles Empty
+    if (t % 7 == 0) {
+      memset(tile, 0, 32 * 32 * 8);
+      continue;
+    }
+
+    for (int i = 0; i < 32 * 32; i++) {
+      int x = i & 31;
+      int y = i >> 5;
+      seed = seed * 1664525 + 1013904223;
+      // Smooth Gradient with Noisy Low Bits
+      unsigned short v = (unsigned short) ((x + y + t) * 509);
+      v ^= (seed >> 24) & 0x3F;
+      tile[i * 4 + 0] = v;
+      tile[i * 4 + 1] = v >> 1;
+      tile[i * 4 + 2] = v >> 2;
+      tile[i * 4 + 3] = 65535;
+    }
+  }
+
+  return (unsigned char*) book;
+}
+
+// ------------------------------
+// UNDO BOOK STREAMED COMPRESSION
+// ------------------------------
+
+static double bench_stream(unsigned char* book, unsigned char* out,
+    int frame, int workers, int job, size_t* bytes, int* jobs) {
+  ZSTD_CCtx* ctx = ZSTD_createCCtx();
+  ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, 4);
+  ZSTD_CCtx_setParameter(ctx, ZSTD_c_nbWorkers, workers);
+  if (workers > 0 && job > 0)
+    ZSTD_CCtx_setParameter(ctx, ZSTD_c_jobSize, job);
+
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  // Stream Pages Like compressPage
+  ZSTD_outBuffer dst = {out, ZSTD_compressBound(BOOK), 0};
+  for (int p = 0; p < BOOK / PAGE; p++) {
+    ZSTD_EndDirective mode = ZSTD_e_continue;
+    if ((p + 1) % frame == 0 || p + 1 == BOOK / PAGE)
+      mode = ZSTD_e_end;
+
+    ZSTD_inBuffer src = {book + (size_t) p * PAGE, PAGE, 0};
+    while (1) {
+      size_t r = ZSTD_compressStream2(ctx, &dst, &src, mode);
+      if (ZSTD_isError(r)) {
+        printf("zstd: %s\n", ZSTD_getErrorName(r));
+        exit(1);
+      }
+
+      if (src.pos >= src.size && (mode == ZSTD_e_continue || r == 0))
+        break;
+    }
+
+    // Count Jobs Started by Frame
+    if (mode == ZSTD_e_end && workers > 0)
+      *jobs += ZSTD_getFrameProgression(ctx).currentJobID;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  ZSTD_freeCCtx(ctx);
+  *bytes = dst.pos;
+  // Return Megabytes per Second
+  double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+  return (BOOK / 1048576.0) / secs;
+}
+
+// ----------------------------
+// UNDO BOOK COMPRESSION RUNNER
+// ----------------------------
+
+int main(int argc, char** argv) {
+  int workers = (argc > 1) ? atoi(argv[1]) : 4;
+  unsigned char* book = book_create();
+  unsigned char* out = malloc(ZSTD_compressBound(BOOK));
+
+  struct {
+    const char* name;
+    int frame, workers, job;
+  } runs[] = {
+    {"8 pages, single thread", 8, 0, 0},
+    {"8 pages, workers", 8, workers, 0},
+    {"32 pages, single thread", 32, 0, 0},
+    {"32 pages, workers, 1MiB jobs", 32, workers, 1 << 20},
+  };
+
+  printf("undo book %d MiB, %d workers\n", BOOK >> 20, workers);
+  for (int i = 0; i < 4; i++) {
+    size_t bytes = 0;
+    int jobs = 0;
+    double mbs = bench_stream(book, out, runs[i].frame,
+      runs[i].workers, runs[i].job, &bytes, &jobs);
+    printf("%-30s %8.1f MB/s  ratio %.2f  jobs %d\n",
+      runs[i].name, mbs, (double) BOOK / bytes, jobs);
+  }
+
+  // Dealloc Buffers
+  free(book);
+  free(out);
+  return 0;
+}
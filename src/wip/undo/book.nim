@@ -1,9 +1,16 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 # Copyright (c) 2024 Cristian Camilo Ruiz <mrgaturus>
 from ../image/chunk import mipmaps
+from std/algorithm import sort
+from std/hashes import hashData
 import ../image/[tiles, context]
 import stream, swap
 
+const
+  # Pages per Compressed Frame
+  # 32 Pages of 128KiB Span Four Jobs
+  bookFrame = 32
+
 type
   NUndoTile = object
     ux, uy: int32
@@ -12,6 +19,9 @@ type
     next: int64
     count, cap: int32
     tiles: UncheckedArray[NUndoTile]
+  NUndoRepair = object
+    tile: NUndoTile
+    chunk: seq[byte]
   # Undo Buffer Pagination
   NUndoRegion = NTileReserved
   NUndoBook* = object
@@ -19,7 +29,8 @@ type
     bpp: int32 # bytes per pixel
     bpt: int32 # bytes per tile
     region: NUndoRegion
-    seek: NUndoSeek
+    seek, index: NUndoSeek
+    frames: seq[NUndoFrame]
     pages: seq[NUndoBuffer]
   # Undo Book Codec
   NUndoStage* = object
@@ -30,6 +41,8 @@ type
     stencil*: ptr NUndoBook
     before*: ptr NUndoBook
     after*: ptr NUndoBook
+    # Mismatched Delta Tiles
+    repairs: seq[NUndoRepair]
   NUndoCodec = object
     bytes, cap: int
     count, idx: int
@@ -50,6 +63,15 @@ proc `=destroy`(book: NUndoBook) =
   for page in book.pages:
     dealloc(page)
   `=destroy`(book.pages)
+  `=destroy`(book.frames)
+
+proc bytes*(book: NUndoBook): int64 =
+  if len(book.pages) > 0:
+    result = book.slabs * book.bpt
+
+proc chunk(book: ptr NUndoBook, cell: int64, cap: int): pointer =
+  let loc = (cell mod cap) * book.bpt
+  result = addr book.pages[cell div cap][loc]
 
 # ------------------------
 # Undo Book Region Manager
@@ -83,7 +105,23 @@ proc regionMark(stage: ptr NUndoStage, r: NUndoRegion) =
 # ----------------------
 
 proc uniform(tile: ptr NUndoTile): bool =
-  (tile.ux and tile.uy and 1) == 0
+  ((tile.ux or tile.uy) and 1) == 0
+
+proc slab(tile: ptr NUndoTile): bool =
+  (tile.ux and 1) == 1
+
+proc delta(tile: ptr NUndoTile): bool =
+  (tile.ux and not tile.uy and 1) == 1
+
+proc unchanged(tile: ptr NUndoTile): bool =
+  (tile.uy and not tile.ux and 1) == 1
+
+# Delta & Unchanged Keep Before Checksum on High Bits
+proc slot(tile: ptr NUndoTile): int64 =
+  cast[int64](tile.cell and 0xFFFFFFFF'u64)
+
+proc sum(tile: ptr NUndoTile): uint32 =
+  uint32(tile.cell shr 32)
 
 proc point(tile: ptr NUndoTile): tuple[x, y: int32] =
   result.x = tile.ux shr 1
@@ -105,6 +143,34 @@ proc asUniform(tile: ptr NUndoTile, value: uint64) =
   # Store Cell as Uniform
   tile.cell = value
 
+proc asDelta(tile: ptr NUndoTile, idx: uint64, sum: uint32) =
+  tile.ux = tile.ux or 1
+  tile.uy = tile.uy and not 1
+  # Store Cell as Delta Index
+  tile.cell = idx or (uint64(sum) shl 32)
+
+proc asUnchanged(tile: ptr NUndoTile, sum: uint32) =
+  tile.ux = tile.ux and not 1
+  tile.uy = tile.uy or 1
+  # Tile Without Data
+  tile.cell = uint64(sum) shl 32
+
+# ------------------------
+# Undo Book Delta Encoding
+# ------------------------
+
+proc delta(dst, src0, src1: pointer, bytes: int) =
+  let
+    d = cast[ptr UncheckedArray[uint64]](dst)
+    s0 = cast[ptr UncheckedArray[uint64]](src0)
+    s1 = cast[ptr UncheckedArray[uint64]](src1)
+  # XOR Tile Words
+  for i in 0 ..< bytes shr 3:
+    d[i] = s0[i] xor s1[i]
+
+proc checksum(buffer: pointer, bytes: int): uint32 =
+  uint32(hashData(buffer, bytes) and 0xFFFFFFFF)
+
 # -----------------------------
 # Undo Book Writter: Pagination
 # -----------------------------
@@ -167,18 +233,24 @@ proc writeBook(stage: ptr NUndoStage, book: ptr NUndoBook): NBookWrite =
 # Undo Book Writter: Encoding
 # ---------------------------
 
-proc write(codec: var NBookWrite, tile: NTile) =
+proc entry(codec: var NBookWrite, tile: NTile): ptr NUndoTile =
   var list = codec.list
   if list.count == list.cap:
     codec.nextList()
     list = codec.list
   # Add Tile to List
   let idx = list.count
-  let t0 = addr list.tiles[idx]
-  t0.point(tile.x, tile.y)
+  result = addr list.tiles[idx]
+  result[] = default(NUndoTile)
+  result.point(tile.x, tile.y)
+  # Next Tile from List
+  inc(list.count)
+
+proc write(codec: var NBookWrite, tile: NTile) =
+  let t0 = codec.entry(tile)
   # Define Tile Data
   case tile.status
-  of tsInvalid, tsZero: discard
+  of tsInvalid, tsZero: t0.asUniform(0)
   of tsColor: t0.asUniform(tile.data.color)
   of tsBuffer:
     let idx = codec.nextSlab()
@@ -187,8 +259,22 @@ proc write(codec: var NBookWrite, tile: NTile) =
     copyMem(codec.chunk,
       tile.data.buffer,
       tile.bytes)
-  # Next Tile from List
-  inc(list.count)
+
+proc write(codec: var NBookWrite, tile: NTile, before: pointer) =
+  if isNil(before) or tile.status != tsBuffer:
+    codec.write(tile)
+    return
+  let t0 = codec.entry(tile)
+  let buffer = tile.data.buffer
+  let sum = checksum(before, tile.bytes)
+  # Store Unchanged Tile Without Data
+  if equalMem(buffer, before, tile.bytes):
+    t0.asUnchanged(sum)
+    return
+  # Store Tile as Delta of Before
+  let idx = codec.nextSlab()
+  t0.asDelta(uint64 idx, sum)
+  delta(codec.chunk, buffer, before, tile.bytes)
 
 proc writeCopy0*(stage: ptr NUndoStage) =
   let book = stage.before
@@ -215,7 +301,7 @@ proc writeMark0*(stage: ptr NUndoStage) =
     let tile = tiles[].find(c.tx, c.ty)
     codec.write(tile)
 
-proc writeMark1*(stage: ptr NUndoStage) =
+proc writeMark1*(stage: ptr NUndoStage, delta = false) =
   let before = stage.before
   let book = stage.after
   assert book != before
@@ -230,9 +316,14 @@ proc writeMark1*(stage: ptr NUndoStage) =
   while not isNil(list):
     let count = list.count
     for idx in 0 ..< count:
-      let (x, y) = point(list.tiles[idx].addr)
+      let t0 = list.tiles[idx].addr
+      let (x, y) = point(t0)
       let tile = tiles[].find(x, y)
-      codec.write(tile)
+      # Lookup Before Tile Chunk
+      var chunk: pointer
+      if delta and t0.slab:
+        chunk = before.chunk(t0.slot, codec.cap)
+      codec.write(tile, chunk)
     # Step Next List
     let next = list.next
     if next == 0:
@@ -264,7 +355,27 @@ proc streamBook*(stream: ptr NUndoStream, book: ptr NUndoBook): NBookStream =
   # Prepare Book Streaming
   if result.count > 0:
     stream.compressStart()
-  else: stream.swap[].startSeek()
+  else: # Empty Seek, Frame and Tile Index
+    stream.swap[].startSeek()
+    setLen(stream.frames, 0)
+    stream.writeFrames()
+    stream.swap[].startSeek()
+
+proc writeIndex(stream: ptr NUndoStream, book: ptr NUndoBook) =
+  let swap = stream.swap
+  let cap = stream.bytes div book.bpt
+  swap[].startSeek()
+  # Write Tile Index from Lists
+  var list = cast[ptr NUndoIndex](book.pages[0])
+  while true:
+    let count = list.count
+    if count > 0:
+      let bytes = count * sizeof(NUndoTile)
+      swap[].write(addr list.tiles[0], bytes)
+    # Step Next List
+    if list.next == 0: break
+    list = cast[ptr NUndoIndex](book.chunk(list.next, cap))
+  book.index = swap[].endSeek()
 
 proc compressPage*(codec: var NBookStream): bool =
   let
@@ -281,9 +392,14 @@ proc compressPage*(codec: var NBookStream): bool =
   let bytes = dabs * book.bpt
   let page = book.pages[codec.idx]
   # Compress Current Page
-  if count > dabs:
-    stream.compressBlock(page, bytes)
-  else: stream.compressEnd(page, bytes)
+  if count <= dabs:
+    stream.compressEnd(page, bytes)
+    book.frames = stream.frames
+    stream.writeFrames()
+    stream.writeIndex(book)
+  elif (codec.idx + 1) mod bookFrame == 0:
+    stream.compressFrame(page, bytes)
+  else: stream.compressBlock(page, bytes)
   # Next Book Page
   codec.count -= step
   inc(codec.idx)
@@ -341,8 +457,8 @@ proc nextTile(codec: var NBookRead): ptr NUndoTile =
     idx = codec.idx
   # Lookup Current Tile
   result = addr list.tiles[idx]
-  if not result.uniform:
-    var cell = cast[int64](result.cell)
+  if result.slab:
+    var cell = result.slot
     if cell >= codec.count * cap:
       codec.nextPage()
     # Lookup Current Tile Chunk
@@ -370,25 +486,55 @@ proc readBook(stream: ptr NUndoStream, book: ptr NUndoBook): NBookRead =
 # Undo Book Reading: Decoding
 # ---------------------------
 
-proc commit(codec: var NBookRead, stage: ptr NUndoStage) =
-  let tiles = stage.tiles
-  let status = stage.status
+proc postpone(stage: ptr NUndoStage, t0: ptr NUndoTile, chunk: pointer) =
+  var repair = NUndoRepair(tile: t0[])
+  # Copy Delta Chunk Before Stream Moves
+  if t0.delta:
+    let bytes = stage.tiles.bytes
+    setLen(repair.chunk, bytes)
+    copyMem(addr repair.chunk[0], chunk, bytes)
+  stage.repairs.add(repair)
+
+proc apply(stage: ptr NUndoStage, t0: ptr NUndoTile, chunk: pointer) =
+  let (x, y) = t0.point()
+  var tile = stage.tiles[].find(x, y)
+  # Check Tile is Exactly on Before State
+  if t0.delta or t0.unchanged:
+    let check = tile.status == tsBuffer and
+      t0.sum == checksum(tile.data.buffer, tile.bytes)
+    if not check:
+      stage.postpone(t0, chunk)
+      return
+  # Apply Tile Changes
+  if t0.unchanged:
+    return
+  elif t0.delta:
+    let buffer = tile.data.buffer
+    delta(buffer, buffer, chunk, tile.bytes)
+    tile.mipmaps()
+  elif t0.slab:
+    tile.toBuffer()
+    copyMem(tile.data.buffer,
+      chunk, tile.bytes)
+    tile.mipmaps()
+  else: tile.toColor(t0.cell)
+  # Apply Dirty Changes
+  stage.status[].mark32(x, y)
+
+proc inside(r: NUndoRegion, t0: ptr NUndoTile): bool =
+  let (x, y) = t0.point()
+  result = x >= r.x and y >= r.y and
+    x < r.x + r.w and y < r.y + r.h
+
+proc commit(codec: var NBookRead, stage: ptr NUndoStage, r: NUndoRegion) =
   # Read Codec Tiles
   while true:
     let t0 = nextTile(codec)
     if isNil(t0): return
-    # Lookup Current Tile
-    let (x, y) = t0.point()
-    var tile = tiles[].find(x, y)
-    # Apply Tile Changes
-    if not t0.uniform:
-      tile.toBuffer()
-      copyMem(tile.data.buffer,
-        codec.chunk, tile.bytes)
-      tile.mipmaps()
-    else: tile.toColor(t0.cell)
-    # Apply Dirty Changes
-    status[].mark32(x, y)
+    if r.inside(t0):
+      stage.apply(t0, codec.chunk)
+
+proc repair(stage: ptr NUndoStage)
 
 proc readBook(stage: ptr NUndoStage, book: ptr NUndoBook) =
   if book.slabs > 0:
@@ -396,7 +542,8 @@ proc readBook(stage: ptr NUndoStage, book: ptr NUndoBook) =
     stage.regionMark(book.region)
     # Commit Book Tiles to Stage Tiles
     var codec = readBook(stage.stream, book)
-    commit(codec, stage)
+    commit(codec, stage, book.region)
+    stage.repair()
 
 proc readRegion(stage: ptr NUndoStage) =
   var r0 = stage.before.region
@@ -426,6 +573,106 @@ proc readAfter*(stage: ptr NUndoStage) =
   stage.readBook(stage.after)
   stage.readRegion()
 
+# --------------------------------
+# Undo Book Reading: Random Access
+# --------------------------------
+
+proc readIndex(stream: ptr NUndoStream, book: ptr NUndoBook,
+    r: NUndoRegion): seq[NUndoTile] =
+  let seek = book.index
+  let count = int(seek.bytes) div sizeof(NUndoTile)
+  var index = newSeq[NUndoTile](count)
+  # Read Tile Index
+  if count > 0:
+    stream.swap[].setRead(seek)
+    stream.swap[].read(addr index[0], seek.bytes)
+  # Filter Tiles Inside Region
+  for t0 in mitems(index):
+    if r.inside(addr t0):
+      result.add(t0)
+  # Sort Tiles by Slab Order
+  result.sort proc (a, b: NUndoTile): int =
+    result = cmp(a.ux and 1, b.ux and 1)
+    if result == 0:
+      const mask = 0xFFFFFFFF'u64
+      result = cmp(a.cell and mask, b.cell and mask)
+
+proc readFrame(stage: ptr NUndoStage, book: ptr NUndoBook,
+    index: var seq[NUndoTile], idx: var int) =
+  let
+    stream = stage.stream
+    cap = stream.bytes div book.bpt
+    frame = int(index[idx].addr.slot div cap) div bookFrame
+    f = book.frames[frame]
+  # Decompress Frame Independently
+  stream.decompressStart NUndoSeek(
+    pos: book.seek.pos + f.pos, bytes: f.bytes)
+  var page = frame * bookFrame
+  var chunk: NUndoBlock
+  while idx < len(index):
+    let t0 = addr index[idx]
+    let cell = t0.slot
+    let p = int(cell div cap)
+    if p div bookFrame != frame:
+      break
+    # Decompress Until Tile Page
+    while page <= p:
+      chunk = stream.decompressBlock()
+      inc(page)
+    # Apply Tile from Page
+    let loc = (cell mod cap) * book.bpt
+    stage.apply(t0, addr chunk.buffer[loc])
+    inc(idx)
+
+proc clip(book: ptr NUndoBook, r0: NUndoRegion): NUndoRegion =
+  let r1 = book.region
+  result.x = max(r0.x, r1.x)
+  result.y = max(r0.y, r1.y)
+  result.w = min(r0.x + r0.w, r1.x + r1.w) - result.x
+  result.h = min(r0.y + r0.h, r1.y + r1.h) - result.y
+
+proc commit(stage: ptr NUndoStage, book: ptr NUndoBook, r: NUndoRegion) =
+  # Commit Book Tiles from Memory
+  if len(book.pages) > 0:
+    var codec = readBook(stage.stream, book)
+    commit(codec, stage, r)
+    return
+  # Commit Book Tiles from Swap Index
+  var index = readIndex(stage.stream, book, r)
+  var idx = 0
+  while idx < len(index):
+    let t0 = addr index[idx]
+    if t0.slab:
+      stage.readFrame(book, index, idx)
+    else:
+      stage.apply(t0, nil)
+      inc(idx)
+
+# ---------------------------------
+# Undo Book Reading: Delta Fallback
+# ---------------------------------
+
+proc repair(stage: ptr NUndoStage) =
+  if len(stage.repairs) == 0:
+    return
+  let before = stage.before
+  var repairs = move stage.repairs
+  for r in mitems(repairs):
+    let t0 = addr r.tile
+    let (x, y) = t0.point()
+    let r0 = NUndoRegion(x: x, y: y, w: 1, h: 1)
+    # Restore Full Before Tile
+    if before != stage.after and before.slabs > 0:
+      stage.commit(before, before.clip(r0))
+    # Apply Delta Again Over Before Tile
+    var chunk: pointer
+    if len(r.chunk) > 0:
+      chunk = addr r.chunk[0]
+    stage.apply(t0, chunk)
+    if len(stage.repairs) > 0:
+      echo "[WARNING] undo tile mismatch at: ", x, ", ", y
+      setLen(stage.repairs, 0)
+
 # ----------------------------
 # Undo Book Reading: Streaming
 # ----------------------------
@@ -437,3 +684,5 @@ proc peekBook*(stream: ptr NUndoStream, book: ptr NUndoBook) =
   # Peek Book Buffer Streaming
   book.region = readObject[NUndoRegion](stream)
   book.seek = stream.swap[].skipSeek()
+  book.frames = stream.readFrames()
+  book.index = stream.swap[].skipSeek()
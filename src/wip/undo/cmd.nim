@@ -78,6 +78,15 @@ proc destroy*(data: var NUndoData, cmd: NUndoCommand) =
   zeroMem(addr data,
     sizeof NUndoData)
 
+proc bytes*(data: var NUndoData, cmd: NUndoCommand): int64 =
+  case cmd # Resident Book Bytes
+  of ucLayerCreate, ucLayerDelete:
+    data.copy.book.bytes()
+  of ucLayerTiles, ucLayerMark:
+    data.mark.before.bytes() +
+    data.mark.after.bytes()
+  else: 0
+
 proc effect*(cmd: NUndoCommand): set[NUndoEffect] =
   const effects = [
     ucCanvasNone: {ueCanvasProps},
@@ -197,7 +206,7 @@ proc capture*(state: var NUndoState) =
         stage.before = stage.stencil
         stage.writeMark1()
     elif step.stage == 1:
-      stage.writeMark1()
+      stage.writeMark1(delta = true)
   of ucLayerProps:
     let props0 = addr step.node.props
     let props = addr step.data.props
@@ -1,9 +1,15 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 # Copyright (c) 2024 Cristian Camilo Ruiz <mrgaturus>
 from typetraits import supportsCopyMem
+from std/cpuinfo import countProcessors
+from std/monotimes import getMonoTime, ticks
 import nogui/libs/zstd
 import swap
 
+const
+  # Multithreaded Job Size
+  streamJob = 1 shl 20
+
 type
   NUndoNumberF = float32|float64
   NUndoNumberI = int8|int16|int32|int64
@@ -19,9 +25,34 @@ type
     buffer*: NUndoBuffer
     bytes*: int64
     pos*: int64
+  # Undo Streaming Frames
+  NUndoFrame* = object
+    pos*, bytes*: int64
+    # Decompressed Bytes
+    raw*: int64
+  NUndoStats* = object
+    frames*: int64
+    # Compressed Throughput
+    bytesIn*, bytesOut*: int64
+    nanos*: int64
+  # Undo Streaming Dictionary
+  NUndoDict* = object
+    cdict, ddict: pointer
+    # Dictionary Identifier
+    id*: uint32
+    bytes*: int
   NUndoStream* = object
     swap*: ptr NUndoSwap
     bytes*, shift*, mask*: int
+    # ZSTD Compression
+    level*, workers*: cint
+    frames*: seq[NUndoFrame]
+    stats*, statsDict*: NUndoStats
+    # ZSTD Dictionaries
+    dicts: seq[NUndoDict]
+    dict*: bool
+    current: int
+    session: bool
     # ZSTD Streaming
     seekRead: NUndoSeek
     auxRead: ZSTD_inBuffer
@@ -34,6 +65,32 @@ type
 proc builtin_ctz*(x: uint32): int32
   {.importc: "__builtin_ctz", cdecl.}
 
+{.push cdecl, header: "zstd.h".}
+proc zstd_createCDict(dict: pointer, size: csize_t, level: cint): pointer
+  {.importc: "ZSTD_createCDict".}
+proc zstd_createDDict(dict: pointer, size: csize_t): pointer
+  {.importc: "ZSTD_createDDict".}
+proc zstd_freeCDict(cdict: pointer): csize_t {.importc: "ZSTD_freeCDict".}
+proc zstd_freeDDict(ddict: pointer): csize_t {.importc: "ZSTD_freeDDict".}
+proc zstd_refCDict(ctx: ptr ZSTD_CCtx, cdict: pointer): csize_t
+  {.importc: "ZSTD_CCtx_refCDict".}
+proc zstd_refDDict(ctx: ptr ZSTD_DStream, ddict: pointer): csize_t
+  {.importc: "ZSTD_DCtx_refDDict".}
+proc zstd_getDictID(dict: pointer, size: csize_t): cuint
+  {.importc: "ZSTD_getDictID_fromDict".}
+proc zstd_getFrameDictID(src: pointer, size: csize_t): cuint
+  {.importc: "ZSTD_getDictID_fromFrame".}
+{.pop.}
+
+var ZSTD_c_jobSize {.importc, header: "zstd.h", nodecl.}: ZSTD_cParameter
+
+{.push cdecl, header: "zdict.h".}
+proc zdict_train(dst: pointer, cap: csize_t, samples: pointer,
+  sizes: ptr csize_t, count: cuint): csize_t {.importc: "ZDICT_trainFromBuffer".}
+proc zdict_isError(code: csize_t): cuint {.importc: "ZDICT_isError".}
+proc zdict_getErrorName(code: csize_t): cstring {.importc: "ZDICT_getErrorName".}
+{.pop.}
+
 proc `=destroy`(raw: NUndoRaw) =
   if not isNil(raw.buffer):
     dealloc(raw.buffer)
@@ -60,10 +117,17 @@ proc configure*(stream: var NUndoStream, swap: ptr NUndoSwap) =
   # Configure ZSTD Streaming
   stream.zstdRead = ZSTD_createDStream()
   stream.zstdWrite = ZSTD_createCStream()
+  # Configure ZSTD Compression
+  stream.level = 4
+  stream.workers = cint min(countProcessors() div 2, 4)
 
 proc destroy*(stream: var NUndoStream) =
   discard ZSTD_freeDStream(stream.zstdRead)
   discard ZSTD_freeCStream(stream.zstdWrite)
+  # Dealloc Dictionaries
+  for dict in stream.dicts:
+    discard zstd_freeCDict(dict.cdict)
+    discard zstd_freeDDict(dict.ddict)
   # Dealloc Buffers
   dealloc(stream.buffer)
   dealloc(stream.aux)
@@ -142,39 +206,139 @@ proc readRaw*(stream: ptr NUndoStream): NUndoRaw =
   let seek = stream.swap[].readSeek()
   result = stream.readRaw(seek)
 
+# --------------------------
+# Undo Streaming: Dictionary
+# --------------------------
+
+proc train*(samples: openArray[byte], sizes: openArray[csize_t],
+    cap: int, level: cint): NUndoDict =
+  if len(samples) == 0 or len(sizes) == 0:
+    return
+  var buffer = newSeq[byte](cap)
+  # Train Dictionary from Samples
+  let code = zdict_train(addr buffer[0], csize_t cap,
+    unsafeAddr samples[0], unsafeAddr sizes[0], cuint len(sizes))
+  if zdict_isError(code) > 0:
+    echo "[WARNING] zstd dictionary: ", zdict_getErrorName(code)
+    return
+  # Create Dictionary Contexts
+  let bytes = csize_t(code)
+  result.cdict = zstd_createCDict(addr buffer[0], bytes, level)
+  result.ddict = zstd_createDDict(addr buffer[0], bytes)
+  result.id = uint32 zstd_getDictID(addr buffer[0], bytes)
+  result.bytes = int(code)
+
+proc install*(stream: var NUndoStream, dict: NUndoDict) =
+  if isNil(dict.cdict) or isNil(dict.ddict):
+    return
+  # Use Dictionary for Next Books
+  stream.dicts.add(dict)
+  stream.current = high(stream.dicts)
+
+proc lookup(stream: ptr NUndoStream, src: pointer, size: int) =
+  let id = uint32 zstd_getFrameDictID(src, csize_t size)
+  if id == 0: return
+  # Reference Dictionary Used by Frame
+  for dict in stream.dicts:
+    if dict.id == id:
+      discard zstd_refDDict(stream.zstdRead, dict.ddict)
+      return
+  echo "[WARNING] zstd dictionary not found: ", id
+
 # ------------------------------
 # Undo Streaming Write: Compress
 # ------------------------------
 
+proc compression*(stream: var NUndoStream, level, workers: cint) =
+  stream.level = level
+  stream.workers = max(workers, 0)
+
+proc parameter(stream: ptr NUndoStream,
+    param: ZSTD_cParameter, value: cint): bool =
+  let ctx = cast[ptr ZSTD_CCtx](stream.zstdWrite)
+  let code = ZSTD_CCtx_setParameter(ctx, param, value)
+  result = ZSTD_isError(code) == 0
+  if not result:
+    echo "[WARNING] zstd parameter: ", ZSTD_getErrorName(code)
+
 proc compressStart*(stream: ptr NUndoStream) =
-  let code = ZSTD_initCStream(stream.zstdWrite, 4)
+  let ctx = cast[ptr ZSTD_CCtx](stream.zstdWrite)
+  let code = ZSTD_CCtx_reset(ctx, ZSTD_reset_session_only)
   if ZSTD_isError(code) > 0:
     echo ZSTD_getErrorName(code)
+  # Configure Level and Workers
+  discard stream.parameter(ZSTD_c_compressionLevel, stream.level)
+  if not stream.parameter(ZSTD_c_nbWorkers, stream.workers):
+    stream.workers = 0
+  # Split Frames into Parallel Jobs
+  if stream.workers > 0:
+    discard stream.parameter(ZSTD_c_jobSize, streamJob)
+  # Configure Current Dictionary
+  var cdict: pointer
+  stream.session = stream.dict and len(stream.dicts) > 0
+  if stream.session:
+    cdict = stream.dicts[stream.current].cdict
+  discard zstd_refCDict(ctx, cdict)
   # Start Compress Seeking
+  setLen(stream.frames, 0)
+  stream.frames.add NUndoFrame()
   stream.swap[].startSeek()
 
+proc counters(stream: ptr NUndoStream): ptr NUndoStats =
+  result = addr stream.stats
+  if stream.session:
+    result = addr stream.statsDict
+
 proc compressBlock*(stream: ptr NUndoStream,
     data: pointer, size: int, mode = ZSTD_e_continue) =
   let swap = stream.swap
   let ctx = stream.zstdWrite
   let chunk = stream.bytes
+  let frame = addr stream.frames[^1]
+  let t0 = ticks getMonoTime()
   # Prepare Buffer Accessors
   var src = ZSTD_inBuffer(src: data, size: size)
   var dst = ZSTD_outBuffer(dst: stream.aux, size: chunk)
   # Compress Buffer Block
-  while src.pos < src.size:
+  while true:
     let r = ZSTD_compressStream2(ctx,
       addr dst, addr src, mode)
+    if ZSTD_isError(r) > 0:
+      echo ZSTD_getErrorName(r)
+      break
+    # Check Block Flushed
+    let done = src.pos >= src.size and
+      (mode == ZSTD_e_continue or r == 0)
     # Stream Buffer to Swap File
-    if r == 0 or dst.pos >= dst.size:
+    if dst.pos > 0 and (done or dst.pos >= dst.size):
       swap[].write(dst.dst, dst.pos)
+      frame.bytes += int64 dst.pos
       dst.dst = stream.aux
       dst.pos = 0
+    if done: break
+  # Accumulate Throughput Counters
+  let stats = stream.counters()
+  stats.nanos += ticks(getMonoTime()) - t0
+  stats.bytesIn += size
+  frame.raw += size
 
-proc compressEnd*(stream: ptr NUndoStream,
+proc compressFrame*(stream: ptr NUndoStream,
     data: pointer, size: int) =
-  # Stream Last Block and End Compress Seeking
+  # Stream Block and End Current Frame
   stream.compressBlock(data, size, ZSTD_e_end)
+  let frame = stream.frames[^1]
+  let stats = stream.counters()
+  stats.bytesOut += frame.bytes
+  inc(stats.frames)
+  # Start Next Frame
+  stream.frames.add NUndoFrame(
+    pos: frame.pos + frame.bytes)
+
+proc compressEnd*(stream: ptr NUndoStream,
+    data: pointer, size: int) =
+  # Stream Last Frame and End Compress Seeking
+  stream.compressFrame(data, size)
+  discard stream.frames.pop()
   discard stream.swap[].endSeek()
 
 proc compressRaw*(stream: ptr NUndoStream, raw: NUndoRaw) =
@@ -183,6 +347,32 @@ proc compressRaw*(stream: ptr NUndoStream, raw: NUndoRaw) =
   stream.compressEnd(
     raw.buffer, raw.bytes)
 
+proc writeFrames*(stream: ptr NUndoStream) =
+  let swap = stream.swap
+  let frames = addr stream.frames
+  swap[].startSeek()
+  # Write Frame Index
+  if len(frames[]) > 0:
+    let bytes = len(frames[]) * sizeof(NUndoFrame)
+    swap[].write(addr frames[][0], bytes)
+  discard swap[].endSeek()
+
+proc readFrames*(stream: ptr NUndoStream): seq[NUndoFrame] =
+  let seek = stream.swap[].readSeek()
+  let count = int(seek.bytes) div sizeof(NUndoFrame)
+  # Read Frame Index
+  setLen(result, count)
+  if count > 0:
+    stream.swap[].read(addr result[0], seek.bytes)
+
+proc throughput*(stats: NUndoStats): float64 =
+  if stats.nanos > 0: # Megabytes per Second
+    result = float64(stats.bytesIn) / float64(stats.nanos) * 1000.0
+
+proc ratio*(stats: NUndoStats): float64 =
+  if stats.bytesOut > 0:
+    result = float64(stats.bytesIn) / float64(stats.bytesOut)
+
 # -------------------------------
 # Undo Streaming Read: Decompress
 # -------------------------------
@@ -191,13 +381,16 @@ proc decompressStart*(stream: ptr NUndoStream, seek: NUndoSeek) =
   let code = ZSTD_initDStream(stream.zstdRead)
   if ZSTD_isError(code) > 0:
     echo ZSTD_getErrorName(code)
-  # Start Decompress Aux
-  stream.auxRead = ZSTD_inBuffer(
-    src: stream.aux)
   # Start Decompress Seeking
+  let bytes = min(seek.bytes, stream.bytes)
   stream.swap[].setRead(seek)
-  stream.seekRead.bytes = seek.bytes
+  stream.seekRead.bytes = seek.bytes - bytes
   stream.seekRead.pos = 0
+  # Start Decompress Aux with Frame Header
+  stream.swap[].read(stream.aux, bytes)
+  stream.auxRead = ZSTD_inBuffer(
+    src: stream.aux, size: bytes)
+  stream.lookup(stream.aux, bytes)
 
 proc decompressStart*(stream: ptr NUndoStream) =
   let seek = stream.swap[].readSeek()
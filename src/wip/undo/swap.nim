@@ -1,5 +1,12 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 # Copyright (c) 2024 Cristian Camilo Ruiz <mrgaturus>
+from std/os import `/`, getCurrentProcessId
+when defined(posix):
+  import std/posix
+
+const
+  # Write-Behind Buffer Size
+  swapPending = 1 shl 20
 
 type
   NUndoSeek* = object
@@ -8,11 +15,17 @@ type
   NUndoSkip* = object
     prev*, next*: int64
     pos*, bytes*: int64
-  # Undo Swap File
-  NUndoSide = enum
-    sideWrite, sideRead
+  # Undo Swap Write-Behind
+  NUndoPending = object
+    buffer: ptr UncheckedArray[byte]
+    pos, bytes: int64
   NUndoSwap* = object
-    file: File
+    fd: cint
+    pending: NUndoPending
+    # Swap File Extent
+    floor*: int64
+    extent, punch: int64
+    reserved: int64
     # Swap Stamping
     seekWrite: NUndoSeek
     stampWrite: NUndoSkip
@@ -20,88 +33,224 @@ type
     # Swap Seeking
     posWrite: int64
     posRead: int64
-    side: NUndoSide
+
+var swapSerial: int
+
+# -------------------------------
+# Undo Swap Positional I/O: Win32
+# -------------------------------
+
+when defined(windows):
+  type Off = int64
+  const
+    O_RDWR = cint 0x0002
+    O_CREAT = cint 0x0100
+    O_TRUNC = cint 0x0200
+    O_BINARY = cint 0x8000
+    # Delete File on Last Close
+    O_TEMPORARY = cint 0x0040
+    # Read & Write Permission
+    S_IRDWR = cint 0x0180
+  {.push header: "<io.h>".}
+  proc c_open(path: cstring, flags: cint): cint
+    {.importc: "_open", varargs.}
+  proc c_close(fd: cint): cint {.importc: "_close".}
+  proc c_lseek(fd: cint, offset: int64, origin: cint): int64
+    {.importc: "_lseeki64".}
+  proc c_read(fd: cint, buf: pointer, count: cuint): cint
+    {.importc: "_read".}
+  proc c_write(fd: cint, buf: pointer, count: cuint): cint
+    {.importc: "_write".}
+  proc c_chsize(fd: cint, size: int64): cint
+    {.importc: "_chsize_s".}
+  {.pop.}
+
+  # MSVCRT Lacks Positional I/O, Seek Before Each Access
+  proc pwrite(fd: cint, buf: pointer, count: int, pos: Off): int =
+    if c_lseek(fd, pos, 0) != pos: return -1
+    result = c_write(fd, buf, cuint count)
+
+  proc pread(fd: cint, buf: pointer, count: int, pos: Off): int =
+    if c_lseek(fd, pos, 0) != pos: return -1
+    result = c_read(fd, buf, cuint count)
+
+  proc ftruncate(fd: cint, size: Off): cint =
+    result = c_chsize(fd, size)
+
+# ---------------------------------
+# Undo Swap File Extent: Allocation
+# ---------------------------------
+
+when defined(linux):
+  proc fallocate(fd, mode: cint, offset, len: Off): cint
+    {.importc: "fallocate", cdecl.}
+
+proc reserve(swap: var NUndoSwap, peak: int64) =
+  if peak <= swap.reserved:
+    return
+  # Reserve Swap Growth by Write-Behind Chunks
+  let bytes = (peak - swap.reserved + swapPending - 1) and not (swapPending - 1)
+  when defined(posix) and not defined(macosx):
+    if posix_fallocate(swap.fd, Off swap.reserved, Off bytes) != 0:
+      echo "[WARNING] failed reserve swap at: ", swap.reserved
+  swap.reserved += bytes
+
+proc release(swap: var NUndoSwap, pos, bytes: int64): bool =
+  result = true
+  # Punch Hole Keeping Swap Size, Only Linux Can
+  when defined(linux):
+    const punchHole = 0x01 or 0x02
+    result = fallocate(swap.fd, punchHole, Off pos, Off bytes) == 0
+
+# ------------------------
+# Undo Swap Positional I/O
+# ------------------------
+
+proc pwriteAll(swap: var NUndoSwap, data: pointer, size, pos: int64): bool =
+  var
+    src = cast[ptr UncheckedArray[byte]](data)
+    done: int64
+  swap.reserve(pos + size)
+  # Write Until Complete
+  while done < size:
+    let r = pwrite(swap.fd, addr src[done], int(size - done), Off(pos + done))
+    if r <= 0: return false
+    done += r
+  result = true
+
+proc preadAll(swap: var NUndoSwap, data: pointer, size, pos: int64): bool =
+  var
+    dst = cast[ptr UncheckedArray[byte]](data)
+    done: int64
+  # Read Until Complete
+  while done < size:
+    let r = pread(swap.fd, addr dst[done], int(size - done), Off(pos + done))
+    if r <= 0: return false
+    done += r
+  result = true
+
+# ----------------------
+# Undo Swap Write-Behind
+# ----------------------
+
+proc flush(swap: var NUndoSwap) =
+  let p = addr swap.pending
+  if p.bytes == 0:
+    return
+  # Write Pending Buffer
+  if not swap.pwriteAll(p.buffer, p.bytes, p.pos):
+    echo "[WARNING] corrupted write at: ", p.pos
+  p.pos += p.bytes
+  p.bytes = 0
+
+proc overlap(swap: var NUndoSwap, pos, size: int64): bool =
+  let p = addr swap.pending
+  result = p.bytes > 0 and
+    pos < p.pos + p.bytes and
+    pos + size > p.pos
+
+proc patch(swap: var NUndoSwap, pos: int64, data: pointer, size: int) =
+  let p = addr swap.pending
+  # Store Inside Pending Buffer
+  if pos >= p.pos and pos + size <= p.pos + p.bytes:
+    copyMem(addr p.buffer[pos - p.pos], data, size)
+    return
+  # Store Directly to Swap File
+  if swap.overlap(pos, size):
+    swap.flush()
+  if not swap.pwriteAll(data, size, pos):
+    echo "[WARNING] corrupted patch at: ", pos
 
 # ------------------------------
 # Undo Swap Creation/Destruction
 # ------------------------------
 
-proc configure*(swap: var NUndoSwap) =
-  if not open(swap.file, "undo.bin", fmReadWrite):
-    echo "[ERROR]: failed creating swap file"
+proc configure*(swap: var NUndoSwap, dir: string) =
+  const flags = O_RDWR or O_CREAT or O_TRUNC
+  let name = "npainter-" & $getCurrentProcessId() & "-" & $swapSerial & ".swap"
+  let path = dir / name
+  inc(swapSerial)
+  # Create Anonymous Swap File
+  when defined(windows):
+    const temporary = O_BINARY or O_TEMPORARY
+    swap.fd = c_open(cstring path, flags or temporary, S_IRDWR)
+  else: swap.fd = posix.open(cstring path, flags, Mode 0o600)
+  if swap.fd < 0:
+    echo "[ERROR]: failed creating swap file: ", path
     quit(1)
+  # Unlink While Open, Windows Deletes on Close
+  when defined(posix):
+    discard posix.unlink(cstring path)
   # Write Padding Header
   var pad: array[4, uint32]
   const head = sizeof(pad)
-  if writeBuffer(swap.file, addr pad, head) != head:
+  if not swap.pwriteAll(addr pad, head, 0):
     echo "[ERROR]: failed configure swap file"
     quit(1)
+  # Allocate Write-Behind Buffer
+  swap.pending.buffer =
+    cast[ptr UncheckedArray[byte]](alloc swapPending)
+  swap.pending.pos = head
+  swap.floor = head
+  swap.extent = head
+  swap.punch = head
   # Initialize Current Seeking
   swap.stampPrev = head
   swap.posWrite = head
   swap.posRead = head
 
 proc destroy*(swap: var NUndoSwap) =
-  close(swap.file)
+  swap.flush()
+  when defined(windows):
+    discard c_close(swap.fd)
+  else: discard posix.close(swap.fd)
+  dealloc(swap.pending.buffer)
   `=destroy`(swap)
 
-# -------------------------
-# Undo Swap Read/Write Side
-# -------------------------
-
-proc makeCurrent(swap: var NUndoSwap, side: NUndoSide) =
-  if swap.side == side:
-    return
-  # Change Current Seek
-  case side:
-  of sideWrite:
-    swap.posRead = getFilePos(swap.file)
-    setFilePos(swap.file, swap.posWrite)
-  of sideRead:
-    flushFile(swap.file)
-    swap.posWrite = getFilePos(swap.file)
-    setFilePos(swap.file, swap.posRead)
-  swap.side = side
-
 # ----------------------------
 # Undo Swap Writting: Stamping
 # ----------------------------
 
-proc skipWrite(swap: var NUndoSwap, skip: ptr NUndoSkip) =
-  const bytes = sizeof(NUndoSkip)
-  # Locate Swap Seeking
-  let pos = skip.pos
-  setFilePos(swap.file, pos)
-  # Write Swap Seeking Header
-  if writeBuffer(swap.file, skip, bytes) != bytes:
-    echo "[WARNING] corrupted stamp write at: ", pos
-  swap.posWrite = pos + bytes
-
 proc connectWrite(swap: var NUndoSwap, skip: ptr NUndoSkip) =
   const bytes = sizeof(skip.pos)
   let prev = abs(skip.prev)
   # Patch Next of Previous
-  setFilePos(swap.file, prev + bytes)
-  if writeBuffer(swap.file, addr skip.pos, bytes) != bytes:
-    echo "[WARNING] corrupted stamp connect at: ", prev
-  setFilePos(swap.file, swap.posWrite)
+  swap.patch(prev + bytes, addr skip.pos, bytes)
 
 # ------------------
 # Undo Swap Writting
 # ------------------
 
 proc setWrite*(swap: var NUndoSwap, skip: NUndoSkip) =
-  swap.makeCurrent(sideWrite)
   if skip == default(NUndoSkip):
     return
   # Locate Swap to Seeking
-  setFilePos(swap.file, skip.pos)
   swap.posWrite = skip.pos
   swap.stampPrev = skip.prev
   swap.stampWrite = skip
 
+proc write*(swap: var NUndoSwap, data: pointer, size: int) =
+  let p = addr swap.pending
+  let pos = swap.posWrite
+  # Restart Pending When Not Contiguous
+  if pos != p.pos + p.bytes:
+    swap.flush()
+    p.pos = pos
+  swap.posWrite += size
+  swap.extent = max(swap.extent, swap.posWrite)
+  # Write Large Buffer Directly
+  if p.bytes + size > swapPending:
+    swap.flush()
+    if size >= swapPending:
+      if not swap.pwriteAll(data, size, pos):
+        echo "[WARNING] corrupted write at: ", swap.posWrite
+      p.pos = swap.posWrite
+      return
+  # Append to Pending Buffer
+  copyMem(addr p.buffer[p.bytes], data, size)
+  p.bytes += size
+
 proc startWrite*(swap: var NUndoSwap) =
-  swap.makeCurrent(sideWrite)
   let stamp = addr swap.stampWrite
   let pos = swap.posWrite
   # Initialize Current Seeking
@@ -114,17 +263,9 @@ proc startWrite*(swap: var NUndoSwap) =
     swap.connectWrite(stamp)
   # Write Current Stamping
   swap.stampPrev = pos
-  swap.skipWrite(stamp)
-
-proc write*(swap: var NUndoSwap, data: pointer, size: int) =
-  swap.makeCurrent(sideWrite)
-  swap.posWrite += size
-  # Write Buffer to Current Swap Seeking
-  if writeBuffer(swap.file, data, size) != size:
-    echo "[WARNING] corrupted write at: ", swap.posWrite
+  swap.write(stamp, sizeof NUndoSkip)
 
 proc startSeek*(swap: var NUndoSwap) =
-  swap.makeCurrent(sideWrite)
   let seek = addr swap.seekWrite
   seek.pos = swap.posWrite
   seek.bytes = 0
@@ -133,74 +274,82 @@ proc startSeek*(swap: var NUndoSwap) =
   swap.write(seek, head)
 
 proc endSeek*(swap: var NUndoSwap): NUndoSeek =
-  swap.makeCurrent(sideWrite)
   result = move swap.seekWrite
-  let pos = swap.posWrite
   # Calculate Seek Bytes
   const head = sizeof(NUndoSeek)
-  result.bytes = pos - result.pos - head
-  # Write Current Seek Again
-  setFilePos(swap.file, result.pos)
-  swap.write(addr result, head)
-  setFilePos(swap.file, pos)
-  swap.posWrite = pos
+  result.bytes = swap.posWrite - result.pos - head
+  # Patch Current Seek
+  swap.patch(result.pos, addr result, head)
 
 proc endWrite*(swap: var NUndoSwap): NUndoSkip =
-  swap.makeCurrent(sideWrite)
   let stamp = addr swap.stampWrite
-  # Current Write Position
-  let pos = swap.posWrite
-  let pos0 = stamp.pos
   # Update Current Write Stamp
   const head = sizeof(NUndoSkip)
-  stamp.bytes = pos - (pos0 + head)
-  swap.skipWrite(stamp)
-  # Restore File Position
-  swap.posWrite = pos
-  setFilePos(swap.file, pos)
-  flushFile(swap.file)
+  stamp.bytes = swap.posWrite - (stamp.pos + head)
+  swap.patch(stamp.pos, stamp, head)
   # Return Stamping
   result = stamp[]
 
+proc patchPrev*(swap: var NUndoSwap, pos: int64) =
+  var prev = pos
+  # Patch Previous as Itself
+  swap.patch(pos, addr prev, sizeof prev)
+
+# --------------------
+# Undo Swap Compacting
+# --------------------
+
+proc compact*(swap: var NUndoSwap) =
+  let floor = swap.floor
+  swap.flush()
+  # Release Evicted Range
+  if floor > swap.punch:
+    let bytes = floor - swap.punch
+    if not swap.release(swap.punch, bytes):
+      echo "[WARNING] failed release swap range at: ", swap.punch
+    swap.punch = floor
+  # Truncate Discarded Tail and Reservation
+  let peak = swap.posWrite
+  if max(swap.extent, swap.reserved) > peak:
+    if ftruncate(swap.fd, Off peak) != 0:
+      echo "[WARNING] failed truncate swap at: ", peak
+    swap.extent = peak
+    swap.reserved = peak
+
 # -----------------
 # Undo Swap Reading
 # -----------------
 
 proc setRead*(swap: var NUndoSwap, skip: NUndoSkip) =
-  swap.makeCurrent(sideRead)
   const head = sizeof(NUndoSkip)
   # Locate Swap to Seeking
-  let pos = skip.pos + head
-  setFilePos(swap.file, pos)
-  swap.posRead = pos
-
-proc setRead*(swap: var NUndoSwap, skip: int64): NUndoSkip =
-  swap.makeCurrent(sideRead)
-  const head = sizeof(NUndoSkip)
-  # Read Current Seeking Header
-  setFilePos(swap.file, skip)
-  if readBuffer(swap.file, addr result, head) != head:
-    echo "[WARNING] corrupted stamp read at: ", skip
-  # Set Current Skip
-  assert result.pos == skip
-  swap.setRead(result)
+  swap.posRead = skip.pos + head
 
 proc setRead*(swap: var NUndoSwap, seek: NUndoSeek) =
-  swap.makeCurrent(sideRead)
   const head = sizeof(NUndoSeek)
-  # Check Seeking Bounds
-  let pos = seek.pos + head
-  setFilePos(swap.file, pos)
-  swap.posRead = pos
+  # Locate Swap to Seeking
+  swap.posRead = seek.pos + head
 
 proc read*(swap: var NUndoSwap, data: pointer, size: int) =
-  swap.makeCurrent(sideRead)
+  let pos = swap.posRead
   swap.posRead += size
+  # Flush Pending When Overlap
+  if swap.overlap(pos, size):
+    swap.flush()
   # Read Buffer From Current Swap Seeking
-  if readBuffer(swap.file, data, size) != size:
+  if not swap.preadAll(data, size, pos):
     echo "[WARNING] corrupted read at: ", swap.posRead
     assert false
 
+proc setRead*(swap: var NUndoSwap, skip: int64): NUndoSkip =
+  const head = sizeof(NUndoSkip)
+  # Read Current Seeking Header
+  swap.posRead = skip
+  swap.read(addr result, head)
+  # Set Current Skip
+  assert result.pos == skip
+  swap.setRead(result)
+
 proc readSkip*(swap: var NUndoSwap): NUndoSkip =
   const head = sizeof(NUndoSkip)
   swap.read(addr result, head)
@@ -215,7 +364,6 @@ proc skipSeek*(swap: var NUndoSwap): NUndoSeek =
   result = swap.readSeek()
   # Skip Seeking Bytes
   swap.posRead += result.bytes
-  setFilePos(swap.file, swap.posRead)
 
 # --------------------------
 # Undo Swap Reading: Predict